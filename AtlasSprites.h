@@ -0,0 +1,54 @@
+// GENERATED by pack_atlas.py from art/ - do not edit by hand
+#ifndef ATLAS_SPRITES_H
+#define ATLAS_SPRITES_H
+
+#include "raylib.h"
+
+// atlas.png; 0x0 when there was no art to pack
+const int ATLAS_WIDTH = 0;
+const int ATLAS_HEIGHT = 0;
+const int ATLAS_MIP_LEVELS = 3; // Levels that stay clean (trilinear filtering)
+
+enum AtlasSprite {
+    SPRITE_CARD_BACK,
+    SPRITE_CARD_FACE_00,
+    SPRITE_CARD_FACE_01,
+    SPRITE_CARD_FACE_02,
+    SPRITE_CARD_FACE_03,
+    SPRITE_CARD_FACE_04,
+    SPRITE_CARD_FACE_05,
+    SPRITE_CARD_FACE_06,
+    SPRITE_CARD_FACE_07,
+    SPRITE_CARD_FACE_08,
+    SPRITE_CARD_FACE_09,
+    SPRITE_CARD_FACE_10,
+    SPRITE_CARD_FACE_11,
+    SPRITE_ICON_MENU,
+    SPRITE_ICON_HELP,
+    SPRITE_ICON_BACK,
+    SPRITE_COUNT
+};
+
+const int SPRITE_CARD_FACE_COUNT = 12; // SPRITE_CARD_FACE_00 onwards
+
+// Pixel rects in atlas.png; zero-sized for missing art
+const Rectangle ATLAS_RECTS[SPRITE_COUNT] = {
+    { 0, 0, 0, 0 }, // CARD_BACK
+    { 0, 0, 0, 0 }, // CARD_FACE_00
+    { 0, 0, 0, 0 }, // CARD_FACE_01
+    { 0, 0, 0, 0 }, // CARD_FACE_02
+    { 0, 0, 0, 0 }, // CARD_FACE_03
+    { 0, 0, 0, 0 }, // CARD_FACE_04
+    { 0, 0, 0, 0 }, // CARD_FACE_05
+    { 0, 0, 0, 0 }, // CARD_FACE_06
+    { 0, 0, 0, 0 }, // CARD_FACE_07
+    { 0, 0, 0, 0 }, // CARD_FACE_08
+    { 0, 0, 0, 0 }, // CARD_FACE_09
+    { 0, 0, 0, 0 }, // CARD_FACE_10
+    { 0, 0, 0, 0 }, // CARD_FACE_11
+    { 0, 0, 0, 0 }, // ICON_MENU
+    { 0, 0, 0, 0 }, // ICON_HELP
+    { 0, 0, 0, 0 }, // ICON_BACK
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "AudioFeedback.h"
+#include "GameClock.h"
+#include "RenderWorker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Constants
+const int AUDIO_SAMPLE_RATE = 44100;
+const int AUDIO_BUFFER_FRAMES = 512;     // ~12 ms: the most a queued sound waits for the mixer
+const double AUDIO_STALE_MS = 100.0;     // Queued longer (audio still locked, a stalled device): dropped
+const float AUDIO_MASTER_GAIN = 0.6f;
+const float AUDIO_ATTACK_SECONDS = 0.002f;
+const float AUDIO_RELEASE_SECONDS = 0.005f; // Fade at a clip's end, so cut-off tails don't click
+const float TWO_PI = 6.2831853f;
+
+// A clip is a few notes: a sine (plus its octave) gliding from 'from' to 'to' Hz, with an
+// exponential decay
+struct Note {
+    float at, seconds;
+    float from, to;
+    float amplitude, decay, octave;
+};
+
+struct SoundRecipe {
+    const Note* notes;
+    int count;
+};
+
+const Note FLIP_NOTES[] = { { 0.0f, 0.04f, 1400, 700, 0.35f, 60, 0.0f } };
+const Note MATCH_NOTES[] = { { 0.0f, 0.18f, 1047, 1047, 0.3f, 14, 0.3f }, { 0.08f, 0.25f, 1319, 1319, 0.3f, 12, 0.3f } };
+// Two detuned low tones beat against each other
+const Note ERROR_NOTES[] = { { 0.0f, 0.22f, 196, 185, 0.3f, 10, 0.5f }, { 0.0f, 0.22f, 207, 196, 0.3f, 10, 0.5f } };
+const Note DIGIT_NOTES[] = { { 0.0f, 0.05f, 880, 880, 0.3f, 45, 0.2f } };
+const Note COMPLETE_NOTES[] = {
+    { 0.0f, 0.35f, 523, 523, 0.25f, 8, 0.3f }, { 0.1f, 0.35f, 659, 659, 0.25f, 8, 0.3f },
+    { 0.2f, 0.35f, 784, 784, 0.25f, 8, 0.3f }, { 0.3f, 0.5f, 1047, 1047, 0.25f, 6, 0.3f }
+};
+#define RECIPE(notes) { notes, (int)(sizeof(notes) / sizeof(notes[0])) }
+const SoundRecipe SOUND_RECIPES[SOUND_COUNT] = {
+    RECIPE(FLIP_NOTES), RECIPE(MATCH_NOTES), RECIPE(ERROR_NOTES), RECIPE(DIGIT_NOTES), RECIPE(COMPLETE_NOTES)
+};
+#undef RECIPE
+
+AudioFeedback& AudioFeedback::Get() {
+    static AudioFeedback instance;
+    return instance;
+}
+
+// raylib's callbacks take no context
+static void MixCallback(void* buffer, unsigned int frames) {
+    AudioFeedback::Get().Mix((float*)buffer, frames);
+}
+
+void AudioFeedback::Init() {
+    Synthesize();
+    for (auto& voice : voices) voice.clip = -1;
+
+    // Web Audio only exists on the page thread
+    RunOnPageThread([this]() {
+        InitAudioDevice();
+        if (!IsAudioDeviceReady()) return;
+        SetAudioStreamBufferSizeDefault(AUDIO_BUFFER_FRAMES);
+        stream = LoadAudioStream(AUDIO_SAMPLE_RATE, 32, 1);
+        SetAudioStreamCallback(stream, MixCallback);
+        PlayAudioStream(stream);
+        ready = true;
+    });
+    if (!ready) printf("No audio device: playing without sound\n");
+}
+
+void AudioFeedback::Shutdown() {
+    if (!ready) return;
+    ready = false;
+    RunOnPageThread([this]() {
+        UnloadAudioStream(stream);
+        CloseAudioDevice();
+    });
+}
+
+void AudioFeedback::Synthesize() {
+    size_t total = 0;
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        float seconds = 0.0f;
+        for (int n = 0; n < SOUND_RECIPES[s].count; n++) {
+            const Note& note = SOUND_RECIPES[s].notes[n];
+            seconds = std::max(seconds, note.at + note.seconds);
+        }
+        clips[s].start = (uint32_t)total;
+        clips[s].length = (uint32_t)(seconds * AUDIO_SAMPLE_RATE);
+        total += clips[s].length;
+    }
+    pcm.assign(total, 0.0f);
+
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        float* clip = pcm.data() + clips[s].start;
+        for (int n = 0; n < SOUND_RECIPES[s].count; n++) {
+            const Note& note = SOUND_RECIPES[s].notes[n];
+            int first = (int)(note.at * AUDIO_SAMPLE_RATE);
+            int count = std::min((int)(note.seconds * AUDIO_SAMPLE_RATE), (int)clips[s].length - first);
+            float phase = 0.0f;
+            for (int i = 0; i < count; i++) {
+                float t = (float)i / AUDIO_SAMPLE_RATE;
+                float left = note.seconds - t;
+                float envelope = std::min(t / AUDIO_ATTACK_SECONDS, 1.0f) * expf(-note.decay * t) *
+                                 std::min(left / AUDIO_RELEASE_SECONDS, 1.0f);
+                float frequency = note.from + (note.to - note.from) * (t / note.seconds);
+                phase += TWO_PI * frequency / AUDIO_SAMPLE_RATE;
+                if (phase > TWO_PI) phase -= TWO_PI;
+                clip[first + i] += note.amplitude * envelope * (sinf(phase) + note.octave * sinf(2.0f * phase));
+            }
+        }
+    }
+}
+
+void AudioFeedback::Play(SoundId sound, float gain) {
+    if (!ready) return;
+    uint32_t head = queueHead.load(std::memory_order_relaxed);
+    uint32_t tail = queueTail.load(std::memory_order_acquire);
+    if (head - tail >= (uint32_t)QUEUE_SIZE) return; // The mixer isn't running (audio still locked)
+    queue[head % QUEUE_SIZE] = { (uint8_t)sound, gain, MonotonicMs() };
+    queueHead.store(head + 1, std::memory_order_release);
+}
+
+void AudioFeedback::StartVoice(const PlayCommand& command) {
+    // A free voice, else the one that has played longest
+    Voice* voice = &voices[0];
+    for (auto& v : voices) {
+        if (v.clip < 0) {
+            voice = &v;
+            break;
+        }
+        if (v.started < voice->started) voice = &v;
+    }
+    voice->clip = command.sound;
+    voice->position = 0;
+    voice->gain = command.gain;
+    voice->started = sampleClock;
+}
+
+void AudioFeedback::Mix(float* out, unsigned int frames) {
+    uint32_t head = queueHead.load(std::memory_order_acquire);
+    uint32_t tail = queueTail.load(std::memory_order_relaxed);
+    if (tail != head) {
+        double now = MonotonicMs();
+        for (; tail != head; tail++) {
+            const PlayCommand& command = queue[tail % QUEUE_SIZE];
+            if (now - command.queuedMs <= AUDIO_STALE_MS) StartVoice(command);
+        }
+        queueTail.store(tail, std::memory_order_release);
+    }
+
+    std::fill(out, out + frames, 0.0f);
+    for (auto& voice : voices) {
+        if (voice.clip < 0) continue;
+        const Clip& clip = clips[voice.clip];
+        const float* samples = pcm.data() + clip.start + voice.position;
+        uint32_t count = std::min((uint32_t)frames, clip.length - voice.position);
+        float gain = voice.gain * AUDIO_MASTER_GAIN;
+        for (uint32_t i = 0; i < count; i++) out[i] += samples[i] * gain;
+        voice.position += count;
+        if (voice.position >= clip.length) voice.clip = -1;
+    }
+    for (unsigned int i = 0; i < frames; i++) out[i] = std::min(std::max(out[i], -1.0f), 1.0f);
+    sampleClock += frames;
+}
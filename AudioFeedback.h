@@ -0,0 +1,80 @@
+#ifndef AUDIO_FEEDBACK_H
+#define AUDIO_FEEDBACK_H
+
+#include "raylib.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// --- Audio feedback ---
+// Short sounds for game actions. Every clip is synthesized once at startup into one PCM
+// buffer; nothing is decoded, loaded or allocated when a sound plays. Play() queues the sound
+// in a lock-free ring that the mixer, running in the audio callback (raylib's device thread
+// natively, the page thread on the web), drains at the start of its next buffer. A play
+// lands one buffer (AUDIO_BUFFER_FRAMES) after the call, well inside a frame.
+// The mixer has a fixed pool of voices; when all are busy a new sound takes over the one
+// that has played longest.
+// Browsers keep audio suspended until the page gets a click, tap or key: minshell.html
+// resumes it on the first one.
+
+enum SoundId {
+    SOUND_FLIP,     // Memory: a card turned
+    SOUND_MATCH,    // Memory: pair found
+    SOUND_ERROR,    // Memory: pair missed; Sudoku: digit that conflicts
+    SOUND_DIGIT,    // Sudoku: digit entered
+    SOUND_COMPLETE, // Board finished
+    SOUND_COUNT
+};
+
+class AudioFeedback {
+public:
+    static AudioFeedback& Get();
+
+    void Init(); // After InitWindow; without an audio device every Play is a no-op
+    void Shutdown();
+
+    // Any thread that runs the game; never blocks
+    void Play(SoundId sound, float gain = 1.0f);
+
+    // Audio callback: fills 'frames' mono float samples
+    void Mix(float* out, unsigned int frames);
+
+private:
+    static const int VOICE_COUNT = 8;
+    static const int QUEUE_SIZE = 32; // Power of two
+
+    struct Clip {
+        uint32_t start;  // In pcm
+        uint32_t length; // Samples
+    };
+    struct Voice {
+        int clip;        // -1: free
+        uint32_t position;
+        float gain;
+        uint64_t started; // Mixer sample clock when it began (voice stealing)
+    };
+    struct PlayCommand {
+        uint8_t sound;
+        float gain;
+        double queuedMs; // MonotonicMs(); the mixer drops sounds that waited too long
+    };
+
+    AudioStream stream = {};
+    std::vector<float> pcm; // Every clip, back to back; filled once by Init
+    Clip clips[SOUND_COUNT] = {};
+    bool ready = false;
+
+    // Game -> mixer, single producer / single consumer
+    PlayCommand queue[QUEUE_SIZE];
+    std::atomic<uint32_t> queueHead{0}; // Written by Play
+    std::atomic<uint32_t> queueTail{0}; // Written by Mix
+
+    // Mixer thread only
+    Voice voices[VOICE_COUNT];
+    uint64_t sampleClock = 0;
+
+    void Synthesize();
+    void StartVoice(const PlayCommand& command);
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include "EffectQuality.h"
+#include "VirtualScreen.h"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+
+// Constants
+const float EFFECTS_OVER_BUDGET_MS = 14.0f;  // p90 frame work time that costs a step (most of a 60 Hz frame)
+const float EFFECTS_HEADROOM_MS = 9.0f;      // ...and that counts as room to win one back
+const int EFFECTS_EVALUATE_FRAMES = 30;      // Frames between decisions
+const float EFFECTS_IGNORE_MS = 250.0f;      // Hidden tab, window drag: not a frame the device drew slowly
+const double EFFECTS_UP_DELAY_MIN = 10.0;    // Seconds
+const double EFFECTS_UP_DELAY_MAX = 160.0;
+const double EFFECTS_UP_FAILED_WITHIN = 5.0; // A step down this soon after stepping up: it did not fit
+const char* EFFECT_TIER_NAMES[EFFECT_TIER_COUNT] = { "full", "reduced", "minimal" };
+const int LADDER_STEPS = EFFECTS_MINIMAL + VirtualScreen::RESOLUTION_LEVELS; // Step 0 is the top
+
+EffectQuality& EffectQuality::Get() {
+    static EffectQuality instance;
+    return instance;
+}
+
+EffectQuality::EffectQuality() : upDelay(EFFECTS_UP_DELAY_MIN) {}
+
+void EffectQuality::Update(float workMs) {
+    if (workMs <= 0.0f || workMs > EFFECTS_IGNORE_MS) return; // No frame drawn yet, or not a trend
+    workTimes[head] = workMs;
+    head = (head + 1) % WINDOW_FRAMES;
+    if (filled < WINDOW_FRAMES) filled++;
+    if (++sinceEvaluate < EFFECTS_EVALUATE_FRAMES) return;
+    sinceEvaluate = 0;
+    Evaluate();
+}
+
+float EffectQuality::Percentile90() {
+    float sorted[WINDOW_FRAMES];
+    std::copy(workTimes, workTimes + filled, sorted);
+    float* nth = sorted + (filled * 9) / 10;
+    std::nth_element(sorted, nth, sorted + filled);
+    return *nth;
+}
+
+void EffectQuality::Evaluate() {
+    if (filled < WINDOW_FRAMES / 2) return; // Startup frames say little about the device
+    float p90 = Percentile90();
+    double now = GetTime();
+
+    if (p90 > EFFECTS_OVER_BUDGET_MS) {
+        headroomSince = -1.0;
+        if (step + 1 >= LADDER_STEPS) return;
+        if (steppedUp && now - lastChange < EFFECTS_UP_FAILED_WITHIN) upDelay = std::min(upDelay * 2.0, EFFECTS_UP_DELAY_MAX);
+        step++;
+        steppedUp = false;
+    } else if (p90 <= EFFECTS_HEADROOM_MS && step > 0) {
+        if (headroomSince < 0.0) headroomSince = now;
+        if (now - headroomSince < upDelay || now - lastChange < upDelay) return;
+        step--;
+        steppedUp = true;
+        headroomSince = -1.0;
+    } else {
+        headroomSince = -1.0; // In between: hold
+        return;
+    }
+    lastChange = now;
+    // The new step's frames start a fresh window
+    filled = 0;
+    head = 0;
+    EffectTier previous = tier;
+    Apply();
+    if (tier != previous) printf("Effects %s (p90 work %.1f ms)\n", EFFECT_TIER_NAMES[tier], p90);
+}
+
+// The ladder: effect tiers first, then resolution levels
+void EffectQuality::Apply() {
+    tier = (EffectTier)std::min(step, (int)EFFECTS_MINIMAL);
+    VirtualScreen::Get().SetResolutionLevel(step - tier); // Prints its own changes
+}
@@ -0,0 +1,55 @@
+#ifndef EFFECT_QUALITY_H
+#define EFFECT_QUALITY_H
+
+// --- Effect quality ---
+// Optional drawing cost steps down on its own when a device can't hold the frame budget, and
+// back up once there is headroom again, so slow machines stay smooth without a settings menu.
+// This is the one controller for both kinds of cost, on a single ladder: the effects go first
+// (blended cage tints, then the card flip animation), then the render resolution a level at a
+// time (VirtualScreen.h); stepping up retraces it, resolution first.
+// Decisions use the 90th percentile of the frame's work time (VirtualScreen::LastWorkMs) over
+// the last couple of seconds, not the frame interval, so a display capped at 30 or 50 Hz
+// loses nothing. A steady handful of slow frames counts, a lone hitch does not. Stepping up
+// needs clearly more headroom than stepping down allows, held for a while, and a step up
+// that fails quickly makes the next wait longer.
+
+enum EffectTier {
+    EFFECTS_FULL,
+    EFFECTS_REDUCED, // Cage tints drawn opaque
+    EFFECTS_MINIMAL, // ...and cards turn without the flip animation
+    EFFECT_TIER_COUNT
+};
+
+class EffectQuality {
+public:
+    static EffectQuality& Get();
+
+    // Once per frame, before drawing, with the last frame's work time
+    void Update(float workMs);
+
+    EffectTier Tier() const { return tier; }
+    bool BlendedCageTints() const { return tier < EFFECTS_REDUCED; }
+    bool SmoothFlips() const { return tier < EFFECTS_MINIMAL; }
+
+private:
+    static const int WINDOW_FRAMES = 120; // Rolling window the percentile is taken over
+
+    float workTimes[WINDOW_FRAMES];       // Milliseconds, ring buffer
+    int head = 0;
+    int filled = 0;
+    int sinceEvaluate = 0;
+
+    int step = 0;                         // On the ladder: 0 = everything on, full resolution
+    EffectTier tier = EFFECTS_FULL;
+    double headroomSince = -1.0;          // GetTime() the percentile last went under the step-up line
+    double lastChange = 0.0;
+    double upDelay;                       // Seconds of headroom before stepping up
+    bool steppedUp = false;               // The last change was a step up
+
+    EffectQuality();
+    float Percentile90();
+    void Evaluate();
+    void Apply();
+};
+
+#endif
@@ -0,0 +1,16 @@
+#include "FixedTimestep.h"
+
+int FixedTimestep::Advance(float frameSeconds) {
+    if (frameSeconds < 0.0f) frameSeconds = 0.0f;
+    accumulator += frameSeconds;
+
+    int steps = (int)(accumulator / STEP + 1e-4); // Tolerate rounding: 1/60 s is exactly two steps
+    if (steps > MAX_STEPS_PER_FRAME) {
+        steps = MAX_STEPS_PER_FRAME;
+        accumulator = STEP * steps; // Drop the backlog beyond the cap
+    }
+    accumulator -= STEP * steps;
+    if (accumulator < 0.0) accumulator = 0.0; // Float rounding
+    totalSteps += steps;
+    return steps;
+}
@@ -0,0 +1,30 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+// --- Fixed-timestep scheduler ---
+// Simulation (animations, timed game states) advances in constant steps of STEP seconds
+// whatever the display rate: each frame adds its real duration to an accumulator and runs
+// as many whole steps as fit. The remainder becomes Alpha(), how far the frame sits
+// between the last two steps, which Draw uses to interpolate. After a hitch at most
+// MAX_STEPS_PER_FRAME are run and the rest of the backlog is dropped, so a long stall
+// slows the animation down instead of making every following frame slower (spiral of death).
+// Input is still read once per frame, before the steps.
+class FixedTimestep {
+public:
+    static const int STEPS_PER_SECOND = 120;
+    static const int MAX_STEPS_PER_FRAME = 8; // ~67 ms of catch-up
+    static constexpr float STEP = 1.0f / STEPS_PER_SECOND;
+
+    // Returns how many steps to simulate for a frame that took frameSeconds
+    int Advance(float frameSeconds);
+    float Alpha() const { return (float)(accumulator / STEP); }
+
+    void Reset() { accumulator = 0.0; }
+    long long TotalSteps() const { return totalSteps; }
+
+private:
+    double accumulator = 0.0;
+    long long totalSteps = 0;
+};
+
+#endif
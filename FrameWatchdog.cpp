@@ -0,0 +1,226 @@
+#include "FrameWatchdog.h"
+#include "Snapshot.h"
+#include "InputLatency.h"
+#include "StartupTimeline.h"
+#include "GameInput.h"
+#include "js_interop.h"
+#include <cstdio>
+#include <cstring>
+
+// Constants
+const float FRAME_BUDGET_MS = 33.0f; // Two 60 Hz frames: anything longer is a visible stall
+const char* HITCH_EXPORT_FILE = "hitches.txt";
+const int FIRST_KEY = 32;  // KEY_SPACE
+const int LAST_KEY = 348;  // KEY_KB_MENU
+
+FrameWatchdog& FrameWatchdog::Get() {
+    static FrameWatchdog instance;
+    return instance;
+}
+
+// --- Spans ---
+ProfileSpan::ProfileSpan(const char* name) {
+    FrameWatchdog& w = FrameWatchdog::Get();
+    slot = -1;
+    if (w.spanCount < FrameWatchdog::MAX_SPANS) {
+        slot = w.spanCount++;
+        FrameWatchdog::Span& span = w.spans[slot];
+        span.name = name;
+        span.startMs = w.SinceFrameStart();
+        span.ms = 0.0f;
+        span.depth = w.depth;
+    }
+    w.depth++;
+}
+
+ProfileSpan::~ProfileSpan() {
+    FrameWatchdog& w = FrameWatchdog::Get();
+    w.depth--;
+    if (slot >= 0) w.spans[slot].ms = w.SinceFrameStart() - w.spans[slot].startMs;
+}
+
+// --- Frame monitoring ---
+float FrameWatchdog::SinceFrameStart() const {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+}
+
+void FrameWatchdog::BeginFrame() {
+    frameStart = std::chrono::steady_clock::now();
+    frameTime = GetTime();
+    spanCount = 0;
+    depth = 0;
+    RecordInputs();
+}
+
+// Raw key/click state only: InputNextKey would steal keys from the games' queues
+void FrameWatchdog::RecordInputs() {
+    auto push = [this](int key, Vector2 position) {
+        InputSample& sample = inputs[inputHead];
+        sample.key = key;
+        sample.position = position;
+        sample.time = frameTime;
+        inputHead = (inputHead + 1) % MAX_INPUTS;
+        if (inputCount < MAX_INPUTS) inputCount++;
+    };
+    if (InputClicked()) push(0, InputPointer());
+    for (int key = FIRST_KEY; key <= LAST_KEY; key++) {
+        if (InputKeyPressed(key)) push(key, { 0, 0 });
+    }
+}
+
+bool FrameWatchdog::EndFrame() {
+    float frameMs = SinceFrameStart();
+    if (frameMs <= FRAME_BUDGET_MS) return false;
+
+    HitchReport& report = hitches[hitchHead];
+    report.number = ++totalHitches;
+    report.time = frameTime;
+    report.frameMs = frameMs;
+    report.appState[0] = '\0';
+    report.gameState[0] = '\0';
+    report.spanCount = spanCount;
+    memcpy(report.spans, spans, sizeof(Span) * spanCount);
+    report.inputCount = inputCount;
+    for (int i = 0; i < inputCount; i++) {
+        report.inputs[i] = inputs[(inputHead - inputCount + i + MAX_INPUTS) % MAX_INPUTS]; // Oldest first
+    }
+    hitchHead = (hitchHead + 1) % HITCH_LOG_SIZE;
+    if (hitchCount < HITCH_LOG_SIZE) hitchCount++;
+    selected = 0;
+
+    printf("Long frame: %.1f ms (hitch #%d, F3 to inspect)\n", frameMs, totalHitches);
+    return true;
+}
+
+void FrameWatchdog::AnnotateHitch(const char* appState, const char* gameState) {
+    if (hitchCount == 0) return;
+    HitchReport& report = hitches[(hitchHead - 1 + HITCH_LOG_SIZE) % HITCH_LOG_SIZE];
+    snprintf(report.appState, sizeof(report.appState), "%s", appState);
+    snprintf(report.gameState, sizeof(report.gameState), "%s", gameState);
+}
+
+// --- Reports ---
+static std::string KeyName(int key) {
+    switch (key) {
+        case KEY_SPACE: return "Space";
+        case KEY_ENTER: return "Enter";
+        case KEY_ESCAPE: return "Esc";
+        case KEY_BACKSPACE: return "Backspace";
+        case KEY_DELETE: return "Delete";
+        case KEY_UP: return "Up";
+        case KEY_DOWN: return "Down";
+        case KEY_LEFT: return "Left";
+        case KEY_RIGHT: return "Right";
+    }
+    char name[16];
+    if (key > FIRST_KEY && key < 127) snprintf(name, sizeof(name), "'%c'", (char)key);
+    else snprintf(name, sizeof(name), "key %d", key);
+    return name;
+}
+
+std::string FrameWatchdog::FormatReport(const HitchReport& report) const {
+    std::string text;
+    char line[160];
+    snprintf(line, sizeof(line), "Hitch #%d at %.2fs: %.1f ms (budget %.0f ms)\n",
+             report.number, report.time, report.frameMs, FRAME_BUDGET_MS);
+    text += line;
+    snprintf(line, sizeof(line), "  State: %s%s%s\n", report.appState, report.gameState[0] ? " / " : "", report.gameState);
+    text += line;
+    for (int i = 0; i < report.spanCount; i++) {
+        const Span& span = report.spans[i];
+        snprintf(line, sizeof(line), "  %*s%-*s %8.2f ms (at +%.1f)\n", span.depth * 2, "",
+                 24 - span.depth * 2, span.name, span.ms, span.startMs);
+        text += line;
+    }
+    text += "  Recent input:";
+    if (report.inputCount == 0) text += " none";
+    for (int i = 0; i < report.inputCount; i++) {
+        const InputSample& input = report.inputs[i];
+        std::string what = input.key == 0
+            ? std::string(TextFormat("click (%d,%d)", (int)input.position.x, (int)input.position.y))
+            : KeyName(input.key);
+        snprintf(line, sizeof(line), " %s %.2fs before;", what.c_str(), report.time - input.time);
+        text += line;
+    }
+    text += "\n";
+    return text;
+}
+
+bool FrameWatchdog::Export() {
+    std::string text;
+    for (int age = hitchCount - 1; age >= 0; age--) text += FormatReport(Recent(age)) + "\n";
+    if (text.empty()) text = "No long frames recorded\n\n";
+    text += InputLatency::Get().FormatReport() + "\n";
+    text += StartupTimeline::Get().FormatReport();
+    CopyToClipboard(text.c_str());
+
+    FILE* f = fopen(SnapshotPath(HITCH_EXPORT_FILE), "w");
+    if (!f) return false;
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+    ok = (fclose(f) == 0) && ok;
+    PersistSaveStorage();
+    printf("Hitch log exported to %s and the clipboard\n", SnapshotPath(HITCH_EXPORT_FILE));
+    return ok;
+}
+
+// --- Overlay ---
+void FrameWatchdog::Update() {
+    if (InputKeyPressed(KEY_F3)) overlayVisible = !overlayVisible;
+    if (!overlayVisible) return;
+    if (InputKeyPressed(KEY_F4)) Export();
+    if (InputKeyPressed(KEY_PAGE_UP) && selected + 1 < hitchCount) selected++;
+    if (InputKeyPressed(KEY_PAGE_DOWN) && selected > 0) selected--;
+}
+
+void FrameWatchdog::DrawOverlay() {
+    if (!overlayVisible) return;
+    const int x = 20, y = 40, width = 760, height = 540;
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.85f));
+    DrawText(TextFormat("HITCH LOG  (%d total, budget %.0f ms)", totalHitches, FRAME_BUDGET_MS), x + 15, y + 12, 20, GOLD);
+    DrawText("F3 close   PgUp/PgDn browse   F4 export", x + 15, y + 38, 14, LIGHTGRAY);
+
+    // Latency percentiles along the bottom, one line per metric
+    const int reportTop = y + height - LAT_COUNT * 16 - 32;
+    std::string latency = InputLatency::Get().FormatReport();
+    int reportLine = reportTop;
+    for (size_t start = 0; start < latency.size(); ) {
+        size_t end = latency.find('\n', start);
+        if (end == std::string::npos) end = latency.size();
+        DrawText(latency.substr(start, end - start).c_str(), x + 15, reportLine, 14, start == 0 ? GOLD : LIGHTGRAY);
+        reportLine += 16;
+        start = end + 1;
+    }
+
+    if (hitchCount == 0) {
+        DrawText("No long frames so far", x + 15, y + 80, 20, RAYWHITE);
+        return;
+    }
+
+    const HitchReport& report = Recent(selected);
+    int line = y + 66;
+    DrawText(TextFormat("#%d  %.1f ms  at %.1fs   (%d of %d)", report.number, report.frameMs, report.time,
+                        selected + 1, hitchCount), x + 15, line, 20, RAYWHITE);
+    line += 26;
+    DrawText(TextFormat("%s  %s", report.appState, report.gameState), x + 15, line, 16, SKYBLUE);
+    line += 28;
+
+    // Span bars, scaled to the frame
+    const int barX = x + 260, barWidth = 340;
+    for (int i = 0; i < report.spanCount && line < reportTop - 40; i++) {
+        const Span& span = report.spans[i];
+        DrawText(span.name, x + 15 + span.depth * 14, line, 16, RAYWHITE);
+        float start = span.startMs / report.frameMs, length = span.ms / report.frameMs;
+        DrawRectangle(barX + (int)(start * barWidth), line + 2, (int)(length * barWidth) + 1, 12,
+                      span.ms > FRAME_BUDGET_MS ? RED : SKYBLUE);
+        DrawText(TextFormat("%.1f ms", span.ms), barX + barWidth + 10, line, 16, LIGHTGRAY);
+        line += 20;
+    }
+
+    std::string inputs = "Input:";
+    for (int i = 0; i < report.inputCount; i++) {
+        const InputSample& input = report.inputs[i];
+        inputs += input.key == 0 ? std::string(" click") : " " + KeyName(input.key);
+        inputs += TextFormat(" (-%.1fs)", report.time - input.time);
+    }
+    DrawText(inputs.c_str(), x + 15, reportTop - 30, 14, LIGHTGRAY);
+}
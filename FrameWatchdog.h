@@ -0,0 +1,100 @@
+#ifndef FRAME_WATCHDOG_H
+#define FRAME_WATCHDOG_H
+
+#include "raylib.h"
+#include <chrono>
+#include <string>
+
+// --- Long-frame watchdog ---
+// UpdateDrawFrame is bracketed by BeginFrame/EndFrame and its expensive parts by ProfileSpan
+// scopes. Any frame over FRAME_BUDGET_MS is copied into a fixed-size hitch log with its
+// span breakdown, the app/game state and the last few inputs, so "it froze when I started
+// Sudoku" comes with the frame that froze. F3 shows the log over any screen, PgUp/PgDn
+// browse it, F4 exports it (hitches.txt in the save folder, and the clipboard).
+
+// Times one named part of the frame; nests (an inner span is drawn indented)
+class ProfileSpan {
+public:
+    explicit ProfileSpan(const char* name);
+    ~ProfileSpan();
+
+private:
+    int slot;
+};
+
+class FrameWatchdog {
+public:
+    static const int MAX_SPANS = 24;     // Per frame; more are not recorded
+    static const int MAX_INPUTS = 8;     // Recent inputs kept with each hitch
+    static const int HITCH_LOG_SIZE = 32;
+
+    static FrameWatchdog& Get();
+
+    void BeginFrame();
+    // True if the frame just ended went over budget; describe it with AnnotateHitch
+    bool EndFrame();
+    void AnnotateHitch(const char* appState, const char* gameState);
+
+    int HitchCount() const { return totalHitches; }
+
+    // Overlay (F3)
+    void Update();
+    void DrawOverlay();
+    bool Export();
+
+private:
+    friend class ProfileSpan;
+
+    struct Span {
+        const char* name; // String literal
+        float startMs;    // From the start of the frame
+        float ms;
+        int depth;
+    };
+
+    struct InputSample {
+        int key;          // 0 for a mouse click
+        Vector2 position; // Mouse position for clicks
+        double time;      // GetTime() of the frame that saw it
+    };
+
+    struct HitchReport {
+        int number;       // 1-based since startup
+        double time;      // GetTime() at the start of the frame
+        float frameMs;
+        char appState[48];
+        char gameState[64];
+        Span spans[MAX_SPANS];
+        int spanCount;
+        InputSample inputs[MAX_INPUTS];
+        int inputCount;
+    };
+
+    // Current frame
+    std::chrono::steady_clock::time_point frameStart;
+    double frameTime;
+    Span spans[MAX_SPANS];
+    int spanCount = 0;
+    int depth = 0;
+
+    // Recent inputs, ring buffer
+    InputSample inputs[MAX_INPUTS];
+    int inputHead = 0;
+    int inputCount = 0;
+
+    // Hitch log, ring buffer (oldest overwritten)
+    HitchReport hitches[HITCH_LOG_SIZE];
+    int hitchHead = 0;
+    int hitchCount = 0;
+    int totalHitches = 0;
+
+    bool overlayVisible = false;
+    int selected = 0; // 0 = most recent
+
+    float SinceFrameStart() const;
+    void RecordInputs();
+    const HitchReport& Recent(int age) const { return hitches[(hitchHead - 1 - age + HITCH_LOG_SIZE) % HITCH_LOG_SIZE]; }
+    std::string FormatReport(const HitchReport& report) const;
+};
+
+#endif
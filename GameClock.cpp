@@ -0,0 +1,57 @@
+#include "GameClock.h"
+#include <chrono>
+
+#if defined(PLATFORM_WEB)
+#include <emscripten.h>
+#endif
+
+double MonotonicMs() {
+#if defined(PLATFORM_WEB)
+    return emscripten_get_now();
+#else
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+double PageClockOffsetMs() {
+#if defined(PLATFORM_WEB)
+    // Both clocks tick together, so the offset is measured once, where performance.now() is the page's
+    static const double offset = MAIN_THREAD_EM_ASM_DOUBLE({ return _emscripten_get_now() - performance.now(); });
+    return offset;
+#else
+    return 0.0;
+#endif
+}
+
+void GameClock::Reset(double elapsedMs) {
+    startMs = MonotonicMs() - elapsedMs;
+    pausedAt = -1.0;
+    stopped = false;
+}
+
+void GameClock::Pause() {
+    if (pausedAt < 0) pausedAt = MonotonicMs();
+}
+
+void GameClock::Resume() {
+    if (pausedAt < 0 || stopped) return;
+    startMs += MonotonicMs() - pausedAt; // The paused stretch never happened
+    pausedAt = -1.0;
+}
+
+void GameClock::Stop() {
+    Pause();
+    stopped = true;
+}
+
+double GameClock::ElapsedMs() const {
+    double now = (pausedAt < 0) ? MonotonicMs() : pausedAt;
+    return now - startMs;
+}
+
+double GameClock::ElapsedAt(double wallMs) const {
+    if (wallMs < 0) return ElapsedMs(); // No input timestamp
+    if (pausedAt >= 0 && wallMs > pausedAt) wallMs = pausedAt;
+    double elapsed = wallMs - startMs;
+    return elapsed < 0 ? 0.0 : elapsed;
+}
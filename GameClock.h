@@ -0,0 +1,38 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+// --- Game clock ---
+// Play time measured against a monotonic millisecond clock instead of summed frame deltas,
+// so hitches neither add nor lose time. Pause() is for the app going away (hidden tab,
+// minimized window); Stop() freezes the clock when a game ends and only Reset() restarts
+// it. ElapsedAt() converts an input's arrival time (InputLatency::InputTime, same clock)
+// to game time, so a finishing move counts when it was made, not when its frame ran.
+
+// Milliseconds from an arbitrary origin. On the web this is emscripten_get_now(): the page's
+// performance.now() in a single-threaded build, but counted from performance.timeOrigin
+// (epoch scale, one origin for every thread) in the -pthread builds.
+double MonotonicMs();
+
+// MonotonicMs() minus the page's performance.now(): add it to a browser event.timeStamp to
+// get MonotonicMs(). 0 natively and in single-threaded web builds.
+double PageClockOffsetMs();
+
+class GameClock {
+public:
+    void Reset(double elapsedMs = 0.0); // Running, starting from elapsedMs (resumed games)
+    void Pause();
+    void Resume();                      // No effect once stopped
+    void Stop();
+    bool IsRunning() const { return pausedAt < 0; }
+
+    double ElapsedMs() const;
+    double ElapsedAt(double wallMs) const; // Game time at a MonotonicMs() instant (clamped)
+    int Seconds() const { return (int)(ElapsedMs() / 1000.0); }
+
+private:
+    double startMs = 0.0;   // MonotonicMs() at which elapsed time was 0, shifted by pauses
+    double pausedAt = 0.0;  // MonotonicMs() when paused/stopped, -1 while running
+    bool stopped = true;
+};
+
+#endif
@@ -0,0 +1,321 @@
+#include "GameInput.h"
+#include "GameClock.h"
+#include "VirtualScreen.h"
+#include <cmath>
+
+#if WORKER_RENDERING
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#include <cstring>
+#endif
+
+// Constants
+const int MAX_TOUCHES = 10;
+const int MAX_PRESSES = MAX_TOUCHES + 1;  // Every finger plus a click
+const float TOUCH_DRAG_SLOP = 12.0f;      // Layout units a finger may wander and still tap
+const double EMULATED_MOUSE_MS = 800.0;   // Mouse presses this soon after a touch are the browser's copy of it
+#if WORKER_RENDERING
+const int INPUT_KEY_COUNT = 512;  // Past KEY_KB_MENU
+const int INPUT_QUEUE_SIZE = 16;  // Same as raylib's key press queue
+const char* INPUT_CANVAS = "#canvas";
+#endif
+
+// --- Touch tracking ---
+// Fed as fingers land, move and lift: straight from the DOM events in the worker build, by
+// polling raylib's touch points otherwise. BeginInputFrame latches it into the frame's view.
+struct TouchTracker {
+    TouchPoint live[MAX_TOUCHES];    // Since the last latch, lifted ones included
+    int liveCount = 0;
+    TouchPoint frame[MAX_TOUCHES];   // This frame's view
+    int frameCount = 0;
+    double lastTouchMs = -1e9;       // MonotonicMs() of the last finger down or up
+
+    TouchPoint* Find(int id) {
+        for (int i = 0; i < liveCount; i++) {
+            if (live[i].id == id && !live[i].released) return &live[i];
+        }
+        return nullptr;
+    }
+
+    void Start(int id, Vector2 position) {
+        lastTouchMs = MonotonicMs();
+        if (Find(id) || liveCount == MAX_TOUCHES) return;
+        live[liveCount++] = { id, position, position, true, false, false };
+    }
+
+    void Move(int id, Vector2 position) {
+        TouchPoint* point = Find(id);
+        if (!point) return;
+        point->position = position;
+        float dx = position.x - point->start.x, dy = position.y - point->start.y;
+        if (sqrtf(dx * dx + dy * dy) > TOUCH_DRAG_SLOP) point->dragging = true;
+    }
+
+    void End(int id, Vector2 position) {
+        lastTouchMs = MonotonicMs();
+        Move(id, position);
+        if (TouchPoint* point = Find(id)) point->released = true;
+    }
+
+    // A finger that landed and lifted between two frames still shows as pressed and released
+    void Latch() {
+        frameCount = liveCount;
+        for (int i = 0; i < liveCount; i++) frame[i] = live[i];
+        int kept = 0;
+        for (int i = 0; i < liveCount; i++) {
+            if (live[i].released) continue;
+            live[kept] = live[i];
+            live[kept].pressed = false;
+            kept++;
+        }
+        liveCount = kept;
+    }
+};
+
+static TouchTracker touches;
+
+// This frame's presses and pointer, built by BeginInputFrame
+static Vector2 presses[MAX_PRESSES];
+static int pressCount = 0;
+static Vector2 pointer = { 0, 0 };
+
+// Merges the mouse's state for the frame with the latched touches
+static void CombinePointers(bool mouseClicked, Vector2 mousePosition) {
+    bool recentTouch = touches.frameCount > 0 || MonotonicMs() - touches.lastTouchMs < EMULATED_MOUSE_MS;
+    pressCount = 0;
+    if (mouseClicked && !recentTouch) presses[pressCount++] = mousePosition;
+    for (int i = 0; i < touches.frameCount; i++) {
+        if (touches.frame[i].pressed) presses[pressCount++] = touches.frame[i].position;
+    }
+    if (touches.frameCount > 0) pointer = touches.frame[touches.frameCount - 1].position;
+    else if (!recentTouch) pointer = mousePosition; // Else where the last finger lifted
+}
+
+int InputPressCount() {
+    return pressCount;
+}
+
+Vector2 InputPress(int index) {
+    return presses[index];
+}
+
+bool InputClicked() {
+    return pressCount > 0;
+}
+
+Vector2 InputPointer() {
+    return (pressCount > 0) ? presses[0] : pointer;
+}
+
+int InputTouchCount() {
+    return touches.frameCount;
+}
+
+const TouchPoint& InputTouch(int index) {
+    return touches.frame[index];
+}
+
+#if !WORKER_RENDERING
+// raylib only reports the fingers down now: landings and lifts are the differences
+static void PollTouches() {
+    int count = GetTouchPointCount();
+    int ids[MAX_TOUCHES];
+    if (count > MAX_TOUCHES) count = MAX_TOUCHES;
+    for (int i = 0; i < count; i++) {
+        ids[i] = GetTouchPointId(i);
+        // Touch positions are in framebuffer pixels: raylib's mouse mapping does not apply
+        Vector2 position = VirtualScreen::Get().ScreenToVirtual(GetTouchPosition(i));
+        if (touches.Find(ids[i])) touches.Move(ids[i], position);
+        else touches.Start(ids[i], position);
+    }
+    for (int i = 0; i < touches.liveCount; i++) {
+        const TouchPoint& point = touches.live[i];
+        bool down = false;
+        for (int j = 0; j < count && !down; j++) down = ids[j] == point.id;
+        if (!down && !point.released) touches.End(point.id, point.position);
+    }
+}
+
+void BeginInputFrame() {
+    PollTouches();
+    touches.Latch();
+    CombinePointers(IsMouseButtonPressed(MOUSE_BUTTON_LEFT), GetMousePosition());
+}
+#else
+
+// The callbacks run on the render thread too (queued by the page thread, run between
+// frames), so none of this is shared between threads
+struct ForwardedInput {
+    bool installed = false;
+    bool down[INPUT_KEY_COUNT] = {};
+    bool pressed[INPUT_KEY_COUNT] = {};        // This frame
+    bool pressedPending[INPUT_KEY_COUNT] = {}; // Since the last BeginInputFrame
+    int queue[INPUT_QUEUE_SIZE];
+    int queueCount = 0, queueRead = 0;
+    int pendingQueue[INPUT_QUEUE_SIZE];
+    int pendingCount = 0;
+    bool clicked = false, clickPending = false;
+    Vector2 pointer = { 0, 0 };                // Mouse, layout coordinates
+    double timeOffset = 0.0;                   // Page event.timeStamp -> MonotonicMs()
+    double frameInputTime = -1.0, pendingInputTime = -1.0;
+};
+
+static ForwardedInput input;
+
+// DOM keyCode (what the GLFW port translates from too) to raylib's KeyboardKey
+static int RaylibKey(const EmscriptenKeyboardEvent* e) {
+    int code = (int)e->keyCode;
+    bool right = e->location == DOM_KEY_LOCATION_RIGHT;
+    if ((code >= 'A' && code <= 'Z') || (code >= '0' && code <= '9') || code == ' ') return code;
+    if (code >= 112 && code <= 123) return KEY_F1 + (code - 112);
+    if (code >= 96 && code <= 105) return KEY_KP_0 + (code - 96);
+    switch (code) {
+        case 8: return KEY_BACKSPACE;
+        case 9: return KEY_TAB;
+        case 13: return KEY_ENTER;
+        case 27: return KEY_ESCAPE;
+        case 33: return KEY_PAGE_UP;
+        case 34: return KEY_PAGE_DOWN;
+        case 35: return KEY_END;
+        case 36: return KEY_HOME;
+        case 37: return KEY_LEFT;
+        case 38: return KEY_UP;
+        case 39: return KEY_RIGHT;
+        case 40: return KEY_DOWN;
+        case 45: return KEY_INSERT;
+        case 46: return KEY_DELETE;
+        case 16: return right ? KEY_RIGHT_SHIFT : KEY_LEFT_SHIFT;
+        case 17: return right ? KEY_RIGHT_CONTROL : KEY_LEFT_CONTROL;
+        case 18: return right ? KEY_RIGHT_ALT : KEY_LEFT_ALT;
+        case 91: return KEY_LEFT_SUPER;
+        case 92: case 93: return KEY_RIGHT_SUPER;
+        case 59: case 186: return KEY_SEMICOLON;
+        case 61: case 187: return KEY_EQUAL;
+        case 173: case 189: return KEY_MINUS;
+        case 188: return KEY_COMMA;
+        case 190: return KEY_PERIOD;
+        case 191: return KEY_SLASH;
+        case 192: return KEY_GRAVE;
+        case 219: return KEY_LEFT_BRACKET;
+        case 220: return KEY_BACKSLASH;
+        case 221: return KEY_RIGHT_BRACKET;
+        case 222: return KEY_APOSTROPHE;
+    }
+    return 0;
+}
+
+static void NoteArrival(double eventTimeStamp) {
+    double arrival = eventTimeStamp + input.timeOffset;
+    if (input.pendingInputTime < 0 || arrival < input.pendingInputTime) input.pendingInputTime = arrival;
+}
+
+static EM_BOOL OnKeyDown(int, const EmscriptenKeyboardEvent* e, void*) {
+    int key = RaylibKey(e);
+    if (key == 0) return 0;
+    input.down[key] = true;
+    if (!e->repeat) {
+        NoteArrival(e->timestamp);
+        input.pressedPending[key] = true;
+        if (input.pendingCount < INPUT_QUEUE_SIZE) input.pendingQueue[input.pendingCount++] = key;
+    }
+    return 0; // Forwarded asynchronously: the page already handled the default action
+}
+
+static EM_BOOL OnKeyUp(int, const EmscriptenKeyboardEvent* e, void*) {
+    int key = RaylibKey(e);
+    if (key != 0) input.down[key] = false;
+    return 0;
+}
+
+// The page reports CSS pixels; raylib's SetMouseOffset/Scale mapping never sees these
+static void MovePointer(const EmscriptenMouseEvent* e) {
+    input.pointer = VirtualScreen::Get().CssToVirtual((float)e->targetX, (float)e->targetY);
+}
+
+static EM_BOOL OnMouseDown(int, const EmscriptenMouseEvent* e, void*) {
+    MovePointer(e);
+    if (e->button == 0) {
+        NoteArrival(e->timestamp);
+        input.clickPending = true;
+    }
+    return 0;
+}
+
+static EM_BOOL OnMouseMove(int, const EmscriptenMouseEvent* e, void*) {
+    MovePointer(e);
+    return 0;
+}
+
+static EM_BOOL OnTouch(int eventType, const EmscriptenTouchEvent* e, void*) {
+    for (int i = 0; i < e->numTouches; i++) {
+        const EmscriptenTouchPoint& t = e->touches[i];
+        if (!t.isChanged) continue;
+        Vector2 position = VirtualScreen::Get().CssToVirtual((float)t.targetX, (float)t.targetY);
+        if (eventType == EMSCRIPTEN_EVENT_TOUCHSTART) {
+            NoteArrival(e->timestamp);
+            touches.Start((int)t.identifier, position);
+        } else if (eventType == EMSCRIPTEN_EVENT_TOUCHMOVE) {
+            touches.Move((int)t.identifier, position);
+        } else {
+            touches.End((int)t.identifier, position); // Cancelled too: the finger is gone either way
+        }
+    }
+    return 0;
+}
+
+// Keys released while the page had focus elsewhere never send keyup here
+static EM_BOOL OnBlur(int, const EmscriptenFocusEvent*, void*) {
+    memset(input.down, 0, sizeof(input.down));
+    return 0;
+}
+
+// The listeners live on the page thread; the callbacks are queued to this (calling) thread
+static void InstallForwarding() {
+    const pthread_t here = EM_CALLBACK_THREAD_CONTEXT_CALLING_THREAD;
+    emscripten_set_keydown_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, 0, OnKeyDown, here);
+    emscripten_set_keyup_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, 0, OnKeyUp, here);
+    emscripten_set_mousedown_callback_on_thread(INPUT_CANVAS, nullptr, 0, OnMouseDown, here);
+    emscripten_set_mousemove_callback_on_thread(INPUT_CANVAS, nullptr, 0, OnMouseMove, here);
+    emscripten_set_touchstart_callback_on_thread(INPUT_CANVAS, nullptr, 0, OnTouch, here);
+    emscripten_set_touchmove_callback_on_thread(INPUT_CANVAS, nullptr, 0, OnTouch, here);
+    emscripten_set_touchend_callback_on_thread(INPUT_CANVAS, nullptr, 0, OnTouch, here);
+    emscripten_set_touchcancel_callback_on_thread(INPUT_CANVAS, nullptr, 0, OnTouch, here);
+    emscripten_set_blur_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, 0, OnBlur, here);
+    input.timeOffset = PageClockOffsetMs(); // event.timeStamp is the page's clock
+    input.installed = true;
+}
+
+void BeginInputFrame() {
+    if (!input.installed) InstallForwarding();
+    memcpy(input.pressed, input.pressedPending, sizeof(input.pressed));
+    memset(input.pressedPending, 0, sizeof(input.pressedPending));
+    memcpy(input.queue, input.pendingQueue, sizeof(int) * input.pendingCount);
+    input.queueCount = input.pendingCount;
+    input.queueRead = 0;
+    input.pendingCount = 0;
+    input.clicked = input.clickPending;
+    input.clickPending = false;
+    input.frameInputTime = input.pendingInputTime;
+    input.pendingInputTime = -1.0;
+    touches.Latch();
+    CombinePointers(input.clicked, input.pointer);
+}
+
+bool InputKeyPressed(int key) {
+    return key > 0 && key < INPUT_KEY_COUNT && input.pressed[key];
+}
+
+bool InputKeyDown(int key) {
+    return key > 0 && key < INPUT_KEY_COUNT && input.down[key];
+}
+
+int InputNextKey() {
+    return (input.queueRead < input.queueCount) ? input.queue[input.queueRead++] : 0;
+}
+
+double TakeForwardedInputTime() {
+    double t = input.frameInputTime;
+    input.frameInputTime = -1.0;
+    return t;
+}
+#endif
@@ -0,0 +1,56 @@
+#ifndef GAME_INPUT_H
+#define GAME_INPUT_H
+
+#include "raylib.h"
+#include "RenderWorker.h"
+
+// --- Keyboard, pointer and touch input ---
+// The app reads input through these rather than raylib directly. Normally they are raylib's
+// own calls. In the worker build (RenderWorker.h) raylib's GLFW input never sees a page
+// event, so the page thread forwards DOM key/mouse/touch events to the render thread
+// (emscripten html5 callbacks targeted at it, delivered between frames) and these read that
+// state, latched once per frame by BeginInputFrame so a frame sees one consistent set of presses.
+//
+// Touch: every finger is tracked on its own (multi-touch). A finger is a press in the frame it
+// lands, like a mouse button going down, so a tap acts at once instead of waiting for the
+// browser's click (minshell.html also makes the canvas touch-action: none, which drops the
+// 300 ms delay and the page's own gestures). Once it has moved TOUCH_DRAG_SLOP layout units
+// it is a drag until it lifts. The mouse events browsers emulate after a touch are ignored.
+
+struct TouchPoint {
+    int id;
+    Vector2 start;    // Layout coordinates (VirtualScreen.h)
+    Vector2 position;
+    bool pressed;     // Landed this frame
+    bool released;    // Lifted this frame; position is where
+    bool dragging;    // Moved past the slop since landing
+};
+
+void BeginInputFrame();
+
+// Every press this frame: a left click, and each finger that landed. InputClicked and
+// InputPointer answer for the first one; games that take several at once walk the list.
+int InputPressCount();
+Vector2 InputPress(int index);
+bool InputClicked();    // Any press this frame
+Vector2 InputPointer(); // In layout coordinates: the newest finger while touching, else the mouse
+
+// Fingers down this frame, including those that lifted since the last one
+int InputTouchCount();
+const TouchPoint& InputTouch(int index);
+
+#if WORKER_RENDERING
+bool InputKeyPressed(int key);
+bool InputKeyDown(int key);
+int InputNextKey();     // Key presses queued this frame, one per call, 0 when empty
+
+// Earliest key/button/touch press latched this frame, as MonotonicMs() (GameClock.h), or -1.
+// InputLatency's browser timestamp for this build.
+double TakeForwardedInputTime();
+#else
+inline bool InputKeyPressed(int key) { return IsKeyPressed(key); }
+inline bool InputKeyDown(int key) { return IsKeyDown(key); }
+inline int InputNextKey() { return GetKeyPressed(); }
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+#include "GameModule.h"
+#include "StartupTimeline.h"
+#include <cstdint>
+#include <cstdio>
+
+#if defined(PLATFORM_WEB) && defined(SPLIT_GAME_MODULES)
+#include <dlfcn.h>
+
+// Side modules sit next to index.html; each exports one entry function
+const char* MODULE_FILES[GAME_COUNT] = { "memory.wasm", "sudoku.wasm" };
+const char* MODULE_ENTRIES[GAME_COUNT] = { "MemoryGameEntry", "KillerSudokuEntry" };
+#else
+// Linked in (MemoryGame.cpp, KillerSudoku.cpp)
+GAME_MODULE_EXPORT const GameModuleEntry* MemoryGameEntry();
+GAME_MODULE_EXPORT const GameModuleEntry* KillerSudokuEntry();
+#endif
+
+GameModules& GameModules::Get() {
+    static GameModules instance;
+    return instance;
+}
+
+void GameModules::Prefetch(GameId game) {
+    if (state[game] == MODULE_LOADING || state[game] == MODULE_LOADED) return;
+#if defined(PLATFORM_WEB) && defined(SPLIT_GAME_MODULES)
+    // Fetch, compile and link happen off the frame; the callbacks run between frames
+    state[game] = MODULE_LOADING;
+    emscripten_dlopen(MODULE_FILES[game], RTLD_NOW, (void*)(intptr_t)game, OnLoaded, OnLoadFailed);
+#else
+    entries[game] = (game == GAME_MEMORY) ? MemoryGameEntry() : KillerSudokuEntry();
+    state[game] = MODULE_LOADED;
+    StartupTimeline::Get().Mark(game == GAME_MEMORY ? STARTUP_MEMORY_CODE : STARTUP_SUDOKU_CODE);
+#endif
+}
+
+void GameModules::OnLoaded(void* game, void* handle) {
+    GameModules& modules = Get();
+    GameId id = (GameId)(intptr_t)game;
+#if defined(PLATFORM_WEB) && defined(SPLIT_GAME_MODULES)
+    typedef const GameModuleEntry* (*EntryFunction)();
+    EntryFunction entry = (EntryFunction)dlsym(handle, MODULE_ENTRIES[id]);
+    if (!entry) {
+        printf("%s has no %s\n", MODULE_FILES[id], MODULE_ENTRIES[id]);
+        OnLoadFailed(game);
+        return;
+    }
+    modules.entries[id] = entry();
+    printf("Loaded %s\n", MODULE_FILES[id]);
+#else
+    (void)handle; // Only the split web build has a module to look into
+#endif
+    modules.state[id] = MODULE_LOADED;
+    StartupTimeline::Get().Mark(id == GAME_MEMORY ? STARTUP_MEMORY_CODE : STARTUP_SUDOKU_CODE);
+}
+
+void GameModules::OnLoadFailed(void* game) {
+    GameId id = (GameId)(intptr_t)game;
+#if defined(PLATFORM_WEB) && defined(SPLIT_GAME_MODULES)
+    printf("Could not load %s: %s\n", MODULE_FILES[id], dlerror());
+#endif
+    Get().state[id] = MODULE_FAILED;
+}
+
+GameModule* GameModules::Create(GameId game) {
+    Prefetch(game);
+    if (state[game] != MODULE_LOADED) return nullptr;
+    return entries[game]->create();
+}
+
+void GameModules::Idle() {
+    for (int g = 0; g < GAME_COUNT; g++) {
+        if (state[g] == MODULE_LOADED && entries[g]->idle) entries[g]->idle();
+    }
+}
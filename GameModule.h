@@ -0,0 +1,83 @@
+#ifndef GAME_MODULE_H
+#define GAME_MODULE_H
+
+#include <string>
+
+// --- Games as modules ---
+// main.cpp drives the games only through GameModule, so each one can be built into its own
+// wasm side module (the split web build, -DSPLIT_GAME_MODULES, see README) that is fetched
+// when the menu first wants it: the core shows the menu without downloading any game code.
+// An instance is created on entering a game and released on returning to the menu.
+// In the other builds the games are linked in and every "load" completes immediately.
+
+enum GameId {
+    GAME_MEMORY,
+    GAME_SUDOKU,
+    GAME_COUNT
+};
+
+class GameModule {
+public:
+    virtual ~GameModule() {}
+
+    // Entered from the menu: resume the autosaved game if allowed and there is one, else start one
+    virtual void Open(bool canResume) = 0;
+    virtual bool StartFromCode(const std::string& code) = 0; // Plays a shared board, false if invalid
+    virtual void Update() = 0;          // Input, once per frame
+    virtual void Step(float /*dt*/) {}  // Fixed-step simulation (FixedTimestep.h), if the game has any
+    virtual void Draw(float alpha) = 0; // alpha: position between the last two steps
+    virtual bool IsActive() = 0;        // False once the player asked for the menu
+    virtual void Close() {}             // After IsActive turned false, just before the instance is released
+
+    virtual bool HasGameInProgress() const = 0;
+    virtual void SaveSnapshot() = 0;
+    virtual void SetPaused(bool paused) = 0;
+    virtual const char* DescribeState() const = 0; // Hitch reports
+};
+
+// What each game exports (MemoryGameEntry, KillerSudokuEntry)
+struct GameModuleEntry {
+    GameModule* (*create)();
+    void (*idle)(); // Background work while the menu is up, may be null
+};
+
+#if defined(PLATFORM_WEB)
+#include <emscripten.h>
+#define GAME_MODULE_EXPORT extern "C" EMSCRIPTEN_KEEPALIVE
+#else
+#define GAME_MODULE_EXPORT extern "C"
+#endif
+
+class GameModules {
+public:
+    static GameModules& Get();
+
+    // Starts loading a game's code if it is not there yet (menu hover); returns at once.
+    // Also retries a load that failed.
+    void Prefetch(GameId game);
+    bool IsLoaded(GameId game) const { return state[game] == MODULE_LOADED; }
+    bool HasFailed(GameId game) const { return state[game] == MODULE_FAILED; }
+
+    // A new instance of a loaded game, owned by the caller; nullptr (and the load is
+    // started) if its code is not loaded yet
+    GameModule* Create(GameId game);
+
+    // Menu idle work of every loaded game
+    void Idle();
+
+private:
+    enum ModuleState {
+        MODULE_NOT_LOADED,
+        MODULE_LOADING,
+        MODULE_LOADED,
+        MODULE_FAILED
+    };
+
+    ModuleState state[GAME_COUNT] = {};
+    const GameModuleEntry* entries[GAME_COUNT] = {};
+
+    static void OnLoaded(void* game, void* handle);
+    static void OnLoadFailed(void* game);
+};
+
+#endif
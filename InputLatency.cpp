@@ -0,0 +1,100 @@
+#include "InputLatency.h"
+#include "GameClock.h"
+#include "GameInput.h"
+#include <cstdio>
+
+#if defined(PLATFORM_WEB) && !WORKER_RENDERING
+#include <emscripten.h>
+
+// Remembers the earliest key/button press not yet handed to a frame. Capture phase, so it
+// runs before raylib's own handlers and whatever they do with the event.
+EM_JS(void, InstallInputTimestamps, (), {
+    Module.pendingInputTime = -1;
+    const stamp = function(e) {
+        if (Module.pendingInputTime < 0 || e.timeStamp < Module.pendingInputTime) Module.pendingInputTime = e.timeStamp;
+    };
+    ['keydown', 'mousedown', 'touchstart'].forEach(function(type) {
+        window.addEventListener(type, stamp, { capture: true, passive: true });
+    });
+});
+
+EM_JS(double, TakeInputTimestamp, (), {
+    const t = Module.pendingInputTime;
+    Module.pendingInputTime = -1;
+    return t;
+});
+#endif
+
+// Constants
+const char* LATENCY_LABELS[LAT_COUNT] = {
+    "Input wait (loop)",
+    "Frame to present",
+    "Card flip",
+    "Card face (anim)",
+    "Match result (wait)",
+    "Digit entry"
+};
+
+InputLatency& InputLatency::Get() {
+    static InputLatency instance;
+    return instance;
+}
+
+void InputLatency::BeginFrame() {
+    frameStart = MonotonicMs();
+    responseCount = 0;
+#if WORKER_RENDERING
+    frameInputTime = TakeForwardedInputTime(); // No window here: the forwarded events carry it
+#elif defined(PLATFORM_WEB)
+    if (!installed) {
+        InstallInputTimestamps();
+        installed = true;
+    }
+    frameInputTime = TakeInputTimestamp();
+    if (frameInputTime >= 0) frameInputTime += PageClockOffsetMs(); // -pthread: MonotonicMs counts from timeOrigin
+#else
+    frameInputTime = lastPoll;
+#endif
+}
+
+void InputLatency::Respond(LatencyMetric metric, double inputTime) {
+    if (inputTime < 0 || responseCount >= MAX_RESPONSES) return;
+    responses[responseCount].metric = metric;
+    responses[responseCount].inputTime = inputTime;
+    responseCount++;
+}
+
+void InputLatency::AfterPresent() {
+    double now = MonotonicMs();
+    lastPoll = now;
+
+    // The loop/frame split is counted once per handled input, not per reaction to it
+    bool handledInput = false;
+    for (int i = 0; i < responseCount; i++) {
+        const Response& r = responses[i];
+        sketches[r.metric].Add((float)(now - r.inputTime));
+        if (r.inputTime == frameInputTime) handledInput = true;
+    }
+    if (handledInput) {
+        sketches[LAT_INPUT_WAIT].Add((float)(frameStart - frameInputTime));
+        sketches[LAT_FRAME].Add((float)(now - frameStart));
+    }
+    responseCount = 0;
+}
+
+std::string InputLatency::FormatReport() const {
+    std::string text = "Input-to-present latency (ms):\n";
+    char line[128];
+    for (int m = 0; m < LAT_COUNT; m++) {
+        const KllSketch& s = sketches[m];
+        if (s.Count() == 0) {
+            snprintf(line, sizeof(line), "  %-20s     -\n", LATENCY_LABELS[m]);
+        } else {
+            snprintf(line, sizeof(line), "  %-20s n=%-5llu p50 %6.1f  p90 %6.1f  p99 %6.1f  max %6.1f\n",
+                     LATENCY_LABELS[m], (unsigned long long)s.Count(), s.Quantile(0.5), s.Quantile(0.9),
+                     s.Quantile(0.99), s.Max());
+        }
+        text += line;
+    }
+    return text;
+}
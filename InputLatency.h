@@ -0,0 +1,58 @@
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include "QuantileSketch.h"
+#include <string>
+
+// --- Input-to-present latency ---
+// Each frame takes the arrival time of the input it is about to handle: the browser's
+// event.timeStamp on the web (listeners installed on first use, or forwarded with the events
+// in the worker build; either way shifted onto MonotonicMs, see PageClockOffsetMs), and natively the moment raylib polled it (the end of the previous
+// EndDrawing - the OS-to-poll delay is not visible from here). When a game reacts to that
+// input it calls Respond(); right after the frame's EndDrawing the latency is measured and
+// added to a sketch per metric.
+// Card faces and match results are responded to later than the click, so those metrics
+// include the flip animation and the MEM_WAITING pause.
+
+enum LatencyMetric {
+    LAT_INPUT_WAIT,    // Input arrival -> start of the frame that handles it (frame loop)
+    LAT_FRAME,         // Start of that frame -> its EndDrawing (update + draw + present)
+    LAT_CARD_FLIP,     // Click/key -> first frame showing the card turning
+    LAT_CARD_FACE,     // Click/key -> first frame showing the card's face (flip animation)
+    LAT_MATCH_RESULT,  // Second card -> match/mismatch shown (MEM_WAITING)
+    LAT_DIGIT_ENTRY,   // Key -> digit drawn in the Sudoku grid
+    LAT_COUNT
+};
+
+class InputLatency {
+public:
+    static const int MAX_RESPONSES = 16; // Per frame
+
+    static InputLatency& Get();
+
+    void BeginFrame();
+    void AfterPresent(); // Right after EndDrawing
+
+    // When the input handled this frame arrived (MonotonicMs(), see GameClock.h), or -1 if there was none
+    double InputTime() const { return frameInputTime; }
+    // The frame being built shows the reaction to the input that arrived at 'inputTime'
+    void Respond(LatencyMetric metric, double inputTime);
+
+    std::string FormatReport() const;
+
+private:
+    struct Response {
+        LatencyMetric metric;
+        double inputTime;
+    };
+
+    KllSketch sketches[LAT_COUNT];
+    Response responses[MAX_RESPONSES];
+    int responseCount = 0;
+    double frameStart = 0.0;
+    double frameInputTime = -1.0;
+    double lastPoll = -1.0; // Native: raylib polls input at the end of EndDrawing
+    bool installed = false;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "InteropChannel.h"
+#include "js_interop.h"
+#include "RenderWorker.h"
+#include <cstdio>
+
+// Constants
+const uint8_t INTEROP_PADDING = 0;
+
+InteropChannel& InteropChannel::Get() {
+    static InteropChannel instance;
+    return instance;
+}
+
+InteropChannel::InteropChannel() {
+    header.head = 0;
+    header.tail = 0;
+    header.capacity = CAPACITY;
+    header.dropped = 0;
+    header.draining = 0;
+    writeHead = 0;
+}
+
+// head == tail means empty, so the writer always leaves at least one byte free
+uint8_t* InteropChannel::Reserve(uint8_t type, uint16_t size) {
+    uint32_t need = FRAME_SIZE + size;
+    uint32_t head = writeHead, tail = header.tail.load(std::memory_order_acquire);
+    uint32_t at;
+    if (head >= tail) {
+        if (CAPACITY - head > need) {
+            at = head;
+        } else if (tail > need) {
+            ring[head] = INTEROP_PADDING; // Reader wraps here
+            at = 0;
+        } else {
+            at = CAPACITY; // Full
+        }
+    } else {
+        at = (tail - head > need) ? head : CAPACITY;
+    }
+
+    if (at == CAPACITY) {
+        if (header.dropped++ == 0) printf("Interop channel full, dropping messages\n");
+        return nullptr;
+    }
+    uint8_t* frame = ring + at;
+    frame[0] = type;
+    frame[1] = (uint8_t)size;
+    frame[2] = (uint8_t)(size >> 8);
+    writeHead = at + need;
+    return frame + FRAME_SIZE;
+}
+
+void InteropChannel::Flush() {
+    header.head.store(writeHead, std::memory_order_release);
+    if (writeHead == header.tail.load(std::memory_order_acquire)) return; // Nothing pending: no JS call at all
+#if WORKER_RENDERING
+    // A page busy for several frames catches up in one drain instead of a queue of them
+    if (header.draining.exchange(1) != 0) return;
+    PostToPageThread([this]() { DrainInteropChannel(&header, ring); });
+#elif defined(PLATFORM_WEB)
+    DrainInteropChannel(&header, ring);
+#else
+    header.tail.store(writeHead, std::memory_order_release);
+#endif
+}
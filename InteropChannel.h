@@ -0,0 +1,54 @@
+#ifndef INTEROP_CHANNEL_H
+#define INTEROP_CHANNEL_H
+
+#include <atomic>
+#include <cstdint>
+
+// --- C++ -> JS message channel ---
+// A byte ring in wasm linear memory. C++ appends typed messages as they happen (score
+// events, stats, telemetry); JS drains the whole ring once per frame in a single call,
+// instead of crossing into JS once per event. Message structs and the JS decoders are
+// generated from interop_messages.txt (see gen_interop.py / InteropMessages.h).
+//
+// Framing: [type u8][payload size u16][payload], little-endian. Type 0 is padding: the
+// rest of the ring is unused and the reader wraps to offset 0. Messages never straddle
+// the end. One writer (the frame loop) and one reader (the drain). In the worker build
+// (RenderWorker.h) the drain runs later on the page thread: writes become visible to it
+// only when Flush publishes head, and only one drain is queued at a time.
+//
+// Natively there is no JS: Flush() discards whatever was written.
+
+class InteropChannel {
+public:
+    static const uint32_t CAPACITY = 16 * 1024;
+    static const uint32_t FRAME_SIZE = 3; // Type + payload size
+
+    // Layout shared with the JS drain (js_interop.cpp): five u32s, then the ring
+    struct Header {
+        std::atomic<uint32_t> head;     // End of the messages flushed so far (C++ only)
+        std::atomic<uint32_t> tail;     // Next read offset (JS only)
+        uint32_t capacity;
+        uint32_t dropped;               // Messages lost because the ring was full
+        std::atomic<uint32_t> draining; // A drain is queued on the page thread (JS clears it)
+    };
+
+    static InteropChannel& Get();
+
+    // Frames a message and returns where its payload goes, or nullptr if the ring is full
+    // (the message is dropped and counted). The payload must be filled before Flush.
+    uint8_t* Reserve(uint8_t type, uint16_t size);
+
+    // Hands everything written this frame to JS. Called once, at the end of the frame.
+    void Flush();
+
+    uint32_t Dropped() const { return header.dropped; }
+
+private:
+    InteropChannel();
+
+    Header header;
+    uint32_t writeHead; // Next write offset; becomes header.head at Flush
+    uint8_t ring[CAPACITY];
+};
+
+#endif
@@ -0,0 +1,91 @@
+// GENERATED by gen_interop.py from interop_messages.txt - do not edit by hand
+#ifndef INTEROP_MESSAGES_H
+#define INTEROP_MESSAGES_H
+
+#include "InteropChannel.h"
+#include <cstring>
+
+enum InteropMessageType : uint8_t {
+    MSG_SCORE_SUBMITTED = 1,
+    MSG_LEADERBOARD_REFRESH = 2,
+    MSG_GAME_FINISHED = 3,
+    MSG_TELEMETRY_EVENT = 4,
+    MSG_STARTUP_MARK = 5,
+};
+
+struct MsgScoreSubmitted {
+    int32_t score;
+    uint8_t sortOrder;
+    int32_t elapsedMs;
+};
+
+struct MsgLeaderboardRefresh {
+};
+
+struct MsgGameFinished {
+    uint8_t game;
+    uint8_t difficulty;
+    int32_t seconds;
+    int32_t score;
+    int32_t moves;
+    int32_t errors;
+};
+
+struct MsgTelemetryEvent {
+    uint8_t event;
+    uint8_t arg;
+    uint16_t value;
+    uint32_t timeMs;
+};
+
+struct MsgStartupMark {
+    uint8_t phase;
+    double ms;
+};
+
+inline bool SendInteropMessage(const MsgScoreSubmitted& m) {
+    uint8_t* p = InteropChannel::Get().Reserve(MSG_SCORE_SUBMITTED, 9);
+    if (!p) return false;
+    memcpy(p + 0, &m.score, 4);
+    memcpy(p + 4, &m.sortOrder, 1);
+    memcpy(p + 5, &m.elapsedMs, 4);
+    return true;
+}
+
+inline bool SendInteropMessage(const MsgLeaderboardRefresh&) {
+    uint8_t* p = InteropChannel::Get().Reserve(MSG_LEADERBOARD_REFRESH, 0);
+    if (!p) return false;
+    return true;
+}
+
+inline bool SendInteropMessage(const MsgGameFinished& m) {
+    uint8_t* p = InteropChannel::Get().Reserve(MSG_GAME_FINISHED, 18);
+    if (!p) return false;
+    memcpy(p + 0, &m.game, 1);
+    memcpy(p + 1, &m.difficulty, 1);
+    memcpy(p + 2, &m.seconds, 4);
+    memcpy(p + 6, &m.score, 4);
+    memcpy(p + 10, &m.moves, 4);
+    memcpy(p + 14, &m.errors, 4);
+    return true;
+}
+
+inline bool SendInteropMessage(const MsgTelemetryEvent& m) {
+    uint8_t* p = InteropChannel::Get().Reserve(MSG_TELEMETRY_EVENT, 8);
+    if (!p) return false;
+    memcpy(p + 0, &m.event, 1);
+    memcpy(p + 1, &m.arg, 1);
+    memcpy(p + 2, &m.value, 2);
+    memcpy(p + 4, &m.timeMs, 4);
+    return true;
+}
+
+inline bool SendInteropMessage(const MsgStartupMark& m) {
+    uint8_t* p = InteropChannel::Get().Reserve(MSG_STARTUP_MARK, 9);
+    if (!p) return false;
+    memcpy(p + 0, &m.phase, 1);
+    memcpy(p + 1, &m.ms, 8);
+    return true;
+}
+
+#endif
@@ -0,0 +1,184 @@
+#include "JobSystem.h"
+#include <cstdio>
+#if JOB_THREADS
+#include <thread>
+#endif
+
+// Constants
+const int MAX_JOB_WORKERS = 8;
+
+static double NowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Index of the worker running on this thread, -1 for the main thread
+static thread_local int currentWorker = -1;
+
+struct JobSystem::Worker {
+    std::mutex lock;
+    std::deque<Job> jobs;
+#if JOB_THREADS
+    std::thread thread;
+#endif
+    std::atomic<uint64_t> jobsRun{0};
+    std::atomic<uint64_t> jobsStolen{0};
+    std::atomic<uint64_t> busyNanos{0};
+};
+
+JobSystem& JobSystem::Get() {
+    static JobSystem instance;
+    return instance;
+}
+
+void JobSystem::Start(int count) {
+#if JOB_THREADS
+    if (!workers.empty()) return;
+    if (count <= 0) count = (int)std::thread::hardware_concurrency() - 1;
+    if (count > MAX_JOB_WORKERS) count = MAX_JOB_WORKERS;
+    stopping = false;
+    startTime = NowSeconds();
+    for (int i = 0; i < count; i++) workers.emplace_back(new Worker());
+    for (int i = 0; i < count; i++) workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    printf("Job system: %d worker thread(s)\n", count);
+#else
+    (void)count; // Single-threaded build: everything runs inline
+#endif
+}
+
+void JobSystem::Shutdown() {
+#if JOB_THREADS
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker->thread.join();
+    LogStats();
+    workers.clear();
+#endif
+}
+
+void JobSystem::Submit(Job job) {
+    if (workers.empty()) {
+        job();
+        return;
+    }
+    // Workers keep their own jobs local; outside submissions are spread round-robin
+    int target = (currentWorker >= 0) ? currentWorker : (int)(nextQueue++ % workers.size());
+    {
+        std::lock_guard<std::mutex> guard(workers[target]->lock);
+        workers[target]->jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> guard(sleepLock); // Pairs with the sleeping worker's predicate check
+        queued++;
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::TakeJob(int self, Job& job, bool& stolen) {
+    int count = (int)workers.size();
+    if (self >= 0) {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queued--;
+            stolen = false;
+            return true;
+        }
+    }
+    int first = (self >= 0) ? self + 1 : (int)(nextQueue.load() % count);
+    for (int k = 0; k < count; k++) {
+        Worker& victim = *workers[(first + k) % count];
+        if (&victim == (self >= 0 ? workers[self].get() : nullptr)) continue;
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.jobs.empty()) continue;
+        job = std::move(victim.jobs.front()); // Oldest job: usually the biggest piece of work
+        victim.jobs.pop_front();
+        queued--;
+        stolen = true;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::RunJob(int self, Job& job, bool stolen) {
+    if (self < 0) {
+        job();
+        return;
+    }
+    Worker& worker = *workers[self];
+    auto start = std::chrono::steady_clock::now();
+    job();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    worker.busyNanos += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    worker.jobsRun++;
+    if (stolen) worker.jobsStolen++;
+}
+
+bool JobSystem::RunOne() {
+    if (workers.empty()) return false;
+    Job job;
+    bool stolen = false;
+    if (!TakeJob(currentWorker, job, stolen)) return false;
+    RunJob(currentWorker, job, stolen);
+    return true;
+}
+
+void JobSystem::WorkerLoop(int self) {
+    currentWorker = self;
+    for (;;) {
+        Job job;
+        bool stolen = false;
+        if (TakeJob(self, job, stolen)) {
+            RunJob(self, job, stolen);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [&] { return queued.load() > 0 || stopping.load(); });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+JobWorkerStats JobSystem::GetWorkerStats(int index) const {
+    JobWorkerStats stats = {0, 0, 0.0, 0.0};
+    if (index < 0 || index >= (int)workers.size()) return stats;
+    const Worker& worker = *workers[index];
+    stats.jobsRun = worker.jobsRun;
+    stats.jobsStolen = worker.jobsStolen;
+    stats.busySeconds = worker.busyNanos * 1e-9;
+    double elapsed = NowSeconds() - startTime;
+    stats.utilization = (elapsed > 0.0) ? stats.busySeconds / elapsed : 0.0;
+    return stats;
+}
+
+void JobSystem::LogStats() const {
+    for (int i = 0; i < (int)workers.size(); i++) {
+        JobWorkerStats s = GetWorkerStats(i);
+        printf("Job worker %d: %llu jobs (%llu stolen), busy %.2fs, utilization %.1f%%\n", i,
+               (unsigned long long)s.jobsRun, (unsigned long long)s.jobsStolen, s.busySeconds, s.utilization * 100.0);
+    }
+}
+
+// --- JobGroup ---
+void JobGroup::Submit(Job job) {
+    std::shared_ptr<std::atomic<int>> counter = pending;
+    (*counter)++;
+    JobSystem::Get().Submit([counter, job]() {
+        job();
+        (*counter)--;
+    });
+}
+
+void JobGroup::Wait() {
+    while (pending->load() > 0) {
+#if JOB_THREADS
+        if (!JobSystem::Get().RunOne()) std::this_thread::yield();
+#else
+        JobSystem::Get().RunOne();
+#endif
+    }
+}
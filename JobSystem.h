@@ -0,0 +1,149 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Worker threads exist natively and in the wasm pthreads build (-pthread)
+#if !defined(PLATFORM_WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+#define JOB_THREADS 1
+#else
+#define JOB_THREADS 0
+#endif
+
+// --- Engine-wide job system ---
+// One scheduler for all background work (generation, solving, simulations...).
+// Each worker owns a deque: it pushes/pops its own jobs at the back and steals from the
+// front of the others'. Without threads (single-threaded wasm), or before Start(), every
+// job simply runs inline inside Submit.
+// Never block on a future inside a job without Wait(): Wait() runs other jobs meanwhile.
+
+typedef std::function<void()> Job;
+
+// Per-worker counters since Start()
+struct JobWorkerStats {
+    uint64_t jobsRun;
+    uint64_t jobsStolen; // Taken from another worker's deque
+    double busySeconds;
+    double utilization;  // busySeconds / seconds since Start()
+};
+
+class JobSystem {
+public:
+    static JobSystem& Get();
+
+    void Start(int workers = 0); // 0 = one per core, minus the main thread
+    void Shutdown();             // Finishes queued jobs, then joins the workers
+    int WorkerCount() const { return (int)workers.size(); }
+
+    void Submit(Job job);
+
+    // Runs one queued job on the calling thread; false if there was none
+    bool RunOne();
+
+    JobWorkerStats GetWorkerStats(int worker) const;
+    void LogStats() const;
+
+private:
+    struct Worker;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> queued{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint32_t> nextQueue{0};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    double startTime = 0.0;
+
+    bool TakeJob(int self, Job& job, bool& stolen);
+    void RunJob(int self, Job& job, bool stolen);
+    void WorkerLoop(int self);
+};
+
+// Completion counter for a batch of jobs
+class JobGroup {
+public:
+    void Submit(Job job);
+    void Wait(); // Helps running jobs until every job of the group is done
+
+private:
+    std::shared_ptr<std::atomic<int>> pending = std::make_shared<std::atomic<int>>(0);
+};
+
+// Result of an asynchronous job, with continuations
+template <typename T>
+class Future {
+public:
+    Future() : state(std::make_shared<State>()) {}
+
+    bool IsReady() const { return state->ready.load(); }
+
+    // Blocks (running other jobs meanwhile) until the value is there
+    const T& Wait() const {
+        while (!state->ready.load()) {
+            if (!JobSystem::Get().RunOne()) {
+                std::unique_lock<std::mutex> lock(state->lock);
+                state->done.wait_for(lock, std::chrono::milliseconds(1), [&] { return state->ready.load(); });
+            }
+        }
+        return state->value;
+    }
+
+    // Runs f(value) as a new job once this one is done
+    template <typename F>
+    auto Then(F f) const -> Future<decltype(f(std::declval<const T&>()))> {
+        typedef decltype(f(std::declval<const T&>())) U;
+        Future<U> next;
+        std::shared_ptr<State> self = state;
+        auto continuation = [self, next, f]() mutable { next.Set(f(self->value)); };
+        {
+            std::lock_guard<std::mutex> guard(state->lock);
+            if (!state->ready.load()) {
+                state->continuations.push_back(continuation);
+                return next;
+            }
+        }
+        JobSystem::Get().Submit(continuation);
+        return next;
+    }
+
+    void Set(T value) {
+        std::vector<Job> continuations;
+        {
+            std::lock_guard<std::mutex> guard(state->lock);
+            state->value = std::move(value);
+            state->ready = true;
+            continuations.swap(state->continuations);
+        }
+        state->done.notify_all();
+        for (auto& job : continuations) JobSystem::Get().Submit(job);
+    }
+
+private:
+    struct State {
+        std::mutex lock;
+        std::condition_variable done;
+        std::atomic<bool> ready{false};
+        T value{};
+        std::vector<Job> continuations;
+    };
+    std::shared_ptr<State> state;
+};
+
+// Runs f() as a job and returns its result as a future
+template <typename F>
+auto Async(F f) -> Future<decltype(f())> {
+    Future<decltype(f())> result;
+    JobSystem::Get().Submit([result, f]() mutable { result.Set(f()); });
+    return result;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef KILLER_PUZZLE_H
+#define KILLER_PUZZLE_H
+
+#include <cstdint>
+
+// Plain description of a Killer Sudoku puzzle (no solution, no player state).
+// Fixed-size and trivially copyable so codes, solvers and transforms can pass it around cheaply.
+struct KillerPuzzle {
+    uint8_t cageOf[81];   // Cage index of every cell (0..cageCount-1)
+    uint8_t cageSum[81];  // Target sum per cage (first cageCount entries used)
+    uint8_t given[81];    // Revealed digit, or 0
+    int cageCount;
+};
+
+// Renumbers cages by first appearance in row-major order so equal puzzles compare equal
+inline void NormalizeCageOrder(KillerPuzzle& p) {
+    int remap[81];
+    uint8_t sums[81];
+    for (int i = 0; i < 81; i++) remap[i] = -1;
+    int next = 0;
+    for (int i = 0; i < 81; i++) {
+        int old = p.cageOf[i];
+        if (remap[old] == -1) {
+            remap[old] = next;
+            sums[next] = p.cageSum[old];
+            next++;
+        }
+        p.cageOf[i] = (uint8_t)remap[old];
+    }
+    for (int c = 0; c < next; c++) p.cageSum[c] = sums[c];
+    p.cageCount = next;
+}
+
+#endif
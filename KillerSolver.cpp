@@ -0,0 +1,577 @@
+#include "KillerSolver.h"
+#include <cstring>
+#include "JobSystem.h"
+#include <vector>
+#include <memory>
+
+// Constants
+const int ALL_DIGITS = 0x1FF; // Bit (d-1) set for digit d
+const int SPLIT_TASKS = 64;         // Frontier size for parallel search; fixed so the split never depends on thread count
+
+static int PopCount(int mask) {
+    int n = 0;
+    while (mask) { mask &= mask - 1; n++; }
+    return n;
+}
+
+static int LowestDigit(int mask) {
+    int d = 1;
+    while (!(mask & 1)) { mask >>= 1; d++; }
+    return d;
+}
+
+static int HighestDigit(int mask) {
+    int d = 0;
+    while (mask) { mask >>= 1; d++; }
+    return d;
+}
+
+// Sum of the 'count' smallest / largest digits in mask
+static int SumLowest(int mask, int count) {
+    int sum = 0;
+    for (int d = 1; d <= 9 && count > 0; d++) {
+        if (mask & (1 << (d - 1))) { sum += d; count--; }
+    }
+    return sum;
+}
+
+static int SumHighest(int mask, int count) {
+    int sum = 0;
+    for (int d = 9; d >= 1 && count > 0; d--) {
+        if (mask & (1 << (d - 1))) { sum += d; count--; }
+    }
+    return sum;
+}
+
+static int BoxOf(int index) {
+    return ((index / 9) / 3) * 3 + (index % 9) / 3;
+}
+
+// Cells of the 27 units: rows, columns, boxes
+struct UnitTable {
+    int cells[27][9];
+    UnitTable() {
+        for (int u = 0; u < 9; u++) {
+            for (int k = 0; k < 9; k++) {
+                cells[u][k] = u * 9 + k;
+                cells[9 + u][k] = k * 9 + u;
+                cells[18 + u][k] = ((u / 3) * 3 + k / 3) * 9 + (u % 3) * 3 + k % 3;
+            }
+        }
+    }
+};
+static const UnitTable UNITS;
+
+// A subtree of the search: the placements leading to it from the root
+struct SearchTask {
+    int count;
+    uint8_t cell[81];
+    uint8_t digit[81];
+};
+
+// State shared by the workers of one parallel search
+struct SharedSearch {
+    int limit;
+    long long taskBudget; // Nodes per subtree, 0 = unlimited
+    uint8_t* solution;
+    std::atomic<int> found{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> aborted{false};
+    std::mutex solutionLock;
+    int solutionTask = -1; // Task that produced the copied solution; the lowest one wins
+
+    // Returns true when the search should stop
+    bool Report(const uint8_t* value, int task) {
+        if (solution) {
+            std::lock_guard<std::mutex> guard(solutionLock);
+            if (solutionTask == -1 || task < solutionTask) {
+                memcpy(solution, value, 81);
+                solutionTask = task;
+            }
+        }
+        if (found.fetch_add(1) + 1 >= limit) stop = true;
+        return stop;
+    }
+};
+
+enum BranchResult { BRANCH_DEAD, BRANCH_SOLVED, BRANCH_SPLIT };
+enum SubtreeState { SUBTREE_PAUSED, SUBTREE_DONE, SUBTREE_STOP }; // Resumable search (KillerProof)
+
+class KillerSolver {
+public:
+    KillerSolver(const KillerPuzzle& puzzle, int limit, uint8_t* solution, long long nodeBudget,
+                 SharedSearch* shared = nullptr)
+        : puzzle(puzzle), limit(limit), solution(solution), nodeBudget(nodeBudget),
+          found(0), nodes(0), aborted(false), shared(shared), task(0), depth(0), enterNode(false) {}
+
+    int Run() {
+        if (!Setup()) return 0;
+        Search();
+        return aborted ? SOLVE_ABORTED : found;
+    }
+
+    // Builds the cage tables and places the givens; false if the puzzle is already contradictory
+    bool Setup() {
+        memset(value, 0, sizeof(value));
+        memset(rowUsed, 0, sizeof(rowUsed));
+        memset(colUsed, 0, sizeof(colUsed));
+        memset(boxUsed, 0, sizeof(boxUsed));
+        memset(cageCells, 0, sizeof(cageCells));
+        for (int c = 0; c < puzzle.cageCount; c++) cageRemaining[c] = puzzle.cageSum[c];
+        for (int i = 0; i < 81; i++) {
+            if (puzzle.cageOf[i] >= puzzle.cageCount) return false;
+            cageCells[puzzle.cageOf[i]]++;
+        }
+        cageStart[0] = 0;
+        for (int c = 0; c < puzzle.cageCount; c++) cageStart[c + 1] = cageStart[c] + cageCells[c];
+        int fill[81];
+        for (int c = 0; c < puzzle.cageCount; c++) fill[c] = cageStart[c];
+        for (int i = 0; i < 81; i++) cageList[fill[puzzle.cageOf[i]]++] = i;
+        for (int c = 0; c < puzzle.cageCount; c++) {
+            bool sameRow = true, sameCol = true, sameBox = true;
+            int first = cageList[cageStart[c]];
+            for (int k = cageStart[c]; k < cageStart[c + 1]; k++) {
+                int cell = cageList[k];
+                sameRow = sameRow && cell / 9 == first / 9;
+                sameCol = sameCol && cell % 9 == first % 9;
+                sameBox = sameBox && BoxOf(cell) == BoxOf(first);
+            }
+            cageDistinct[c] = sameRow || sameCol || sameBox;
+        }
+
+        // Givens first; a contradiction here means the puzzle has no solution
+        for (int i = 0; i < 81; i++) {
+            int d = puzzle.given[i];
+            if (d == 0) continue;
+            if (d > 9 || !(Candidates(i) & (1 << (d - 1)))) return false;
+            Place(i, d);
+        }
+        for (int c = 0; c < puzzle.cageCount; c++) {
+            if (cageRemaining[c] < cageCells[c] || cageRemaining[c] > 9 * cageCells[c]) return false;
+        }
+        return true;
+    }
+
+    // --- Parallel search support ---
+    void Enter(const SearchTask& t) {
+        for (int k = 0; k < t.count; k++) Place(t.cell[k], t.digit[k]);
+    }
+
+    void Leave(const SearchTask& t) {
+        for (int k = t.count - 1; k >= 0; k--) Remove(t.cell[k]);
+    }
+
+    // Searches one task's subtree; returns true when the whole search should stop.
+    // A subtree that runs out of its own budget only ends itself: the others still run, so
+    // which subtrees were cut short never depends on thread timing.
+    bool SearchSubtree(const SearchTask& t, int taskIndex) {
+        task = taskIndex;
+        nodes = 0;
+        aborted = false;
+        Enter(t);
+        bool stop = Search();
+        Leave(t);
+        if (!aborted) return stop;
+        shared->aborted = true;
+        return shared->stop.load();
+    }
+
+    // --- Resumable search (KillerProof) ---
+    // SearchSubtree with Search()'s recursion kept in 'frames', so it can pause after any
+    // node and carry on from there on the next call
+    void BeginSubtree(const SearchTask& t, int taskIndex) {
+        task = taskIndex;
+        nodes = 0;
+        aborted = false;
+        Enter(t);
+        entered = t;
+        depth = 0;
+        enterNode = true;
+    }
+
+    // Visits up to 'slice' more nodes (decremented as they are spent)
+    SubtreeState ResumeSubtree(long long& slice) {
+        for (;;) {
+            if (enterNode) {
+                if (slice <= 0) return SUBTREE_PAUSED;
+                slice--;
+                enterNode = false;
+                bool stop = OutOfBudget();
+                if (!stop) {
+                    int best, mask;
+                    BranchResult result = PickBranch(best, mask);
+                    if (result == BRANCH_SOLVED) stop = Report();
+                    else if (result == BRANCH_SPLIT) frames[depth++] = { best, mask, 0 };
+                }
+                if (stop) return EndSubtree(true);
+            }
+            if (depth == 0) return EndSubtree(false);
+
+            // Next digit of the innermost open branch, or back up one level
+            Frame& frame = frames[depth - 1];
+            if (frame.digit) Remove(frame.cell);
+            int d = frame.digit + 1;
+            while (d <= 9 && !(frame.mask & (1 << (d - 1)))) d++;
+            if (d > 9) { depth--; continue; }
+            frame.digit = d;
+            Place(frame.cell, d);
+            enterNode = true;
+        }
+    }
+
+    // Appends the children of 'in' in digit order (nothing if dead, itself if solved);
+    // returns true if it branched
+    bool Expand(const SearchTask& in, std::vector<SearchTask>& out) {
+        Enter(in);
+        int cell, mask;
+        BranchResult result = PickBranch(cell, mask);
+        Leave(in);
+        if (result == BRANCH_DEAD) return false;
+        if (result == BRANCH_SOLVED) { out.push_back(in); return false; }
+        for (int d = 1; d <= 9; d++) {
+            if (!(mask & (1 << (d - 1)))) continue;
+            SearchTask child = in;
+            child.cell[child.count] = (uint8_t)cell;
+            child.digit[child.count] = (uint8_t)d;
+            child.count++;
+            out.push_back(child);
+        }
+        return true;
+    }
+
+private:
+    const KillerPuzzle& puzzle;
+    int limit;
+    uint8_t* solution;
+    long long nodeBudget;
+    int found;
+    long long nodes;
+    bool aborted;
+    SharedSearch* shared; // Non-null when this solver is one worker of a parallel search
+    int task;
+
+    uint8_t value[81];
+    int rowUsed[9], colUsed[9], boxUsed[9];
+    int cageRemaining[81]; // Sum still missing per cage
+    int cageCells[81];     // Empty cells left per cage
+    int cageStart[82];     // Cells of cage c are cageList[cageStart[c]..cageStart[c+1])
+    int cageList[81];
+    bool cageDistinct[81]; // All cells share a row, column or box
+
+    struct Frame {
+        int cell;
+        int mask;
+        int digit; // Placed now, 0 before the first
+    };
+    Frame frames[81];      // Resumable search: open branches, outermost first
+    int depth;
+    bool enterNode;        // The node just placed still has to be visited
+    SearchTask entered;
+
+    // Same outcome as SearchSubtree's
+    SubtreeState EndSubtree(bool stopped) {
+        while (depth > 0) {
+            Frame& frame = frames[--depth];
+            if (frame.digit) Remove(frame.cell);
+        }
+        Leave(entered);
+        if (aborted) {
+            shared->aborted = true;
+            stopped = shared->stop.load();
+        }
+        return stopped ? SUBTREE_STOP : SUBTREE_DONE;
+    }
+
+    int FreeDigits(int index) const {
+        return ALL_DIGITS & ~(rowUsed[index / 9] | colUsed[index % 9] | boxUsed[BoxOf(index)]);
+    }
+
+    int Candidates(int index) const {
+        int mask = FreeDigits(index);
+        int cage = puzzle.cageOf[index];
+        int sum = cageRemaining[cage];
+
+        // Digit d is only possible if the other empty cells of the cage can still make up
+        // (sum - d) with the digits their row/col/box leave them
+        int othersMin = 0, othersMax = 0, othersCount = 0, othersUnion = 0;
+        for (int k = cageStart[cage]; k < cageStart[cage + 1]; k++) {
+            int other = cageList[k];
+            if (other == index || value[other] != 0) continue;
+            int free = FreeDigits(other);
+            if (free == 0) return 0;
+            othersMin += LowestDigit(free);
+            othersMax += HighestDigit(free);
+            othersUnion |= free;
+            othersCount++;
+        }
+
+        // Cages inside one row/col/box can't repeat digits: the others need that many
+        // distinct digits from what is left once d is taken
+        if (cageDistinct[cage] && othersCount > 0) {
+            int result = 0;
+            for (int d = 1; d <= 9; d++) {
+                int bit = 1 << (d - 1);
+                if (!(mask & bit)) continue;
+                int pool = othersUnion & ~bit;
+                if (PopCount(pool) < othersCount) continue;
+                if (sum - d >= SumLowest(pool, othersCount) && sum - d <= SumHighest(pool, othersCount)) result |= bit;
+            }
+            return result;
+        }
+
+        int lo = sum - othersMax;
+        int hi = sum - othersMin;
+        if (lo < 1) lo = 1;
+        if (hi > 9) hi = 9;
+        if (lo > hi) return 0;
+        int range = ((1 << hi) - 1) & ~((1 << (lo - 1)) - 1);
+        return mask & range;
+    }
+
+    void Place(int index, int d) {
+        int bit = 1 << (d - 1);
+        value[index] = (uint8_t)d;
+        rowUsed[index / 9] |= bit;
+        colUsed[index % 9] |= bit;
+        boxUsed[BoxOf(index)] |= bit;
+        cageRemaining[puzzle.cageOf[index]] -= d;
+        cageCells[puzzle.cageOf[index]]--;
+    }
+
+    void Remove(int index) {
+        int d = value[index];
+        int bit = 1 << (d - 1);
+        value[index] = 0;
+        rowUsed[index / 9] &= ~bit;
+        colUsed[index % 9] &= ~bit;
+        boxUsed[BoxOf(index)] &= ~bit;
+        cageRemaining[puzzle.cageOf[index]] += d;
+        cageCells[puzzle.cageOf[index]]++;
+    }
+
+    // Chooses the cell to branch on (fewest candidates, or a hidden single) and its digits
+    BranchResult PickBranch(int& best, int& bestMask) {
+        int cand[81];
+        best = -1;
+        bestMask = 0;
+        int bestCount = 10;
+        for (int i = 0; i < 81; i++) {
+            if (value[i] != 0) continue;
+            int mask = Candidates(i);
+            int count = PopCount(mask);
+            if (count == 0) return BRANCH_DEAD;
+            cand[i] = mask;
+            if (count < bestCount) {
+                best = i; bestMask = mask; bestCount = count;
+            }
+        }
+        if (best == -1) return BRANCH_SOLVED;
+
+        // Every unit needs each missing digit somewhere: none left is a dead end,
+        // exactly one place is a forced move (hidden single)
+        if (bestCount > 1) {
+            for (int u = 0; u < 27; u++) {
+                int seenOnce = 0, seenTwice = 0, placed = 0;
+                for (int k = 0; k < 9; k++) {
+                    int cell = UNITS.cells[u][k];
+                    if (value[cell] != 0) { placed |= 1 << (value[cell] - 1); continue; }
+                    seenTwice |= seenOnce & cand[cell];
+                    seenOnce |= cand[cell];
+                }
+                if ((seenOnce | placed) != ALL_DIGITS) return BRANCH_DEAD;
+                int single = seenOnce & ~seenTwice;
+                if (single) {
+                    int bit = single & -single;
+                    for (int k = 0; k < 9; k++) {
+                        int cell = UNITS.cells[u][k];
+                        if (value[cell] == 0 && (cand[cell] & bit)) { best = cell; bestMask = bit; break; }
+                    }
+                    break;
+                }
+            }
+        }
+        return BRANCH_SPLIT;
+    }
+
+    bool OutOfBudget() {
+        if (shared) {
+            if (shared->taskBudget > 0 && ++nodes > shared->taskBudget) {
+                aborted = true;
+                return true;
+            }
+            return shared->stop.load(std::memory_order_relaxed);
+        }
+        if (nodeBudget > 0 && ++nodes > nodeBudget) {
+            aborted = true;
+            return true;
+        }
+        return false;
+    }
+
+    bool Report() {
+        if (shared) return shared->Report(value, task);
+        if (found == 0 && solution) memcpy(solution, value, 81);
+        found++;
+        return found >= limit;
+    }
+
+    // Returns true when the search should stop (limit reached or budget exhausted)
+    bool Search() {
+        if (OutOfBudget()) return true;
+
+        int best, bestMask;
+        BranchResult result = PickBranch(best, bestMask);
+        if (result == BRANCH_DEAD) return false;
+        if (result == BRANCH_SOLVED) return Report();
+
+        for (int d = 1; d <= 9; d++) {
+            if (!(bestMask & (1 << (d - 1)))) continue;
+            Place(best, d);
+            bool stop = Search();
+            Remove(best);
+            if (stop) return true;
+        }
+        return false;
+    }
+};
+
+int SolveKiller(const KillerPuzzle& puzzle, int limit, uint8_t* solution, long long nodeBudget) {
+    KillerSolver solver(puzzle, limit < 1 ? 1 : limit, solution, nodeBudget);
+    return solver.Run();
+}
+
+// Per-worker task deque: the owner takes from the front (lowest task index first, as the
+// sequential search would), thieves take from the back
+struct TaskQueue {
+    std::mutex lock;
+    std::deque<int> tasks;
+
+    bool Pop(int& task, bool steal) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (tasks.empty()) return false;
+        if (steal) { task = tasks.back(); tasks.pop_back(); }
+        else { task = tasks.front(); tasks.pop_front(); }
+        return true;
+    }
+};
+
+static void RunWorker(const KillerPuzzle& puzzle, SharedSearch& shared, const std::vector<SearchTask>& tasks,
+                      std::vector<TaskQueue>& queues, int self) {
+    KillerSolver solver(puzzle, shared.limit, nullptr, 0, &shared);
+    solver.Setup(); // Already known to succeed
+    int workers = (int)queues.size();
+    while (!shared.stop) {
+        int task = -1;
+        bool got = queues[self].Pop(task, false);
+        for (int k = 1; !got && k < workers; k++) got = queues[(self + k) % workers].Pop(task, true);
+        if (!got) break; // Tasks are never added after the split, so empty everywhere means done
+        if (solver.SearchSubtree(tasks[task], task)) break;
+    }
+}
+
+// Deterministic split: expand the tree level by level in digit order until there are
+// SPLIT_TASKS subtrees. Tasks stay in the sequential search's order. False if there are none.
+static bool SplitSearch(const KillerPuzzle& puzzle, std::vector<SearchTask>& tasks) {
+    KillerSolver splitter(puzzle, 1, nullptr, 0);
+    if (!splitter.Setup()) return false;
+    tasks.assign(1, SearchTask());
+    tasks[0].count = 0;
+    std::vector<SearchTask> next;
+    while ((int)tasks.size() < SPLIT_TASKS) {
+        next.clear();
+        bool branched = false;
+        for (const SearchTask& t : tasks) branched |= splitter.Expand(t, next);
+        tasks.swap(next);
+        if (!branched) break; // Only solved leaves (or nothing) left
+    }
+    return !tasks.empty();
+}
+
+// The budget is dealt out per subtree, so an aborted result is reproducible too
+static void PrepareShared(SharedSearch& shared, int limit, long long nodeBudget, size_t taskCount, uint8_t* solution) {
+    shared.limit = limit;
+    shared.taskBudget = (nodeBudget > 0) ? (nodeBudget + (long long)taskCount - 1) / (long long)taskCount : 0;
+    shared.solution = solution;
+}
+
+static int SharedResult(const SharedSearch& shared) {
+    int found = shared.found;
+    if (found >= shared.limit) return shared.limit;
+    return shared.aborted ? SOLVE_ABORTED : found;
+}
+
+int SolveKillerParallel(const KillerPuzzle& puzzle, int limit, uint8_t* solution, long long nodeBudget, int threads) {
+    // The caller is one of the workers; the rest are jobs on the shared scheduler
+    int available = JobSystem::Get().WorkerCount() + 1;
+    if (threads <= 0 || threads > available) threads = available;
+    if (threads <= 1 && nodeBudget == 0) return SolveKiller(puzzle, limit, solution);
+    if (limit < 1) limit = 1;
+
+    std::vector<SearchTask> tasks;
+    if (!SplitSearch(puzzle, tasks)) return 0;
+    SharedSearch shared;
+    PrepareShared(shared, limit, nodeBudget, tasks.size(), solution);
+
+    // Deal tasks round-robin so every worker starts near the front of the tree
+    if (threads > (int)tasks.size()) threads = (int)tasks.size();
+    std::vector<TaskQueue> queues(threads);
+    for (int k = 0; k < (int)tasks.size(); k++) queues[k % threads].tasks.push_back(k);
+
+    // A worker job that starts late just finds its deque stolen empty and returns
+    JobGroup group;
+    for (int w = 1; w < threads; w++) {
+        group.Submit([&puzzle, &shared, &tasks, &queues, w]() { RunWorker(puzzle, shared, tasks, queues, w); });
+    }
+    RunWorker(puzzle, shared, tasks, queues, 0);
+    group.Wait();
+    return SharedResult(shared);
+}
+
+// --- KillerProof ---
+struct KillerProof::Search {
+    KillerPuzzle puzzle;
+    SharedSearch shared;
+    std::vector<SearchTask> tasks;
+    KillerSolver solver; // After puzzle and shared, which it refers to
+    size_t next = 0;     // Next subtree to begin
+    bool inSubtree = false;
+
+    explicit Search(const KillerPuzzle& p) : puzzle(p), solver(puzzle, 2, nullptr, 0, &shared) {}
+};
+
+KillerProof::KillerProof() {}
+KillerProof::~KillerProof() {}
+
+void KillerProof::Start(const KillerPuzzle& puzzle, long long nodeBudget) {
+    search.reset(new Search(puzzle));
+    done = false;
+    result = 0;
+    if (!SplitSearch(search->puzzle, search->tasks) || !search->solver.Setup()) {
+        done = true;
+        search.reset();
+        return;
+    }
+    PrepareShared(search->shared, 2, nodeBudget, search->tasks.size(), nullptr);
+}
+
+bool KillerProof::Step(long long sliceNodes) {
+    if (done || !search) return done;
+    Search& s = *search;
+    while (sliceNodes > 0) {
+        if (!s.inSubtree) {
+            if (s.next == s.tasks.size()) break;
+            s.solver.BeginSubtree(s.tasks[s.next], (int)s.next);
+            s.next++;
+            s.inSubtree = true;
+        }
+        SubtreeState state = s.solver.ResumeSubtree(sliceNodes);
+        if (state == SUBTREE_PAUSED) return false;
+        s.inSubtree = false;
+        if (state == SUBTREE_STOP) break;
+    }
+    if (s.inSubtree || (s.next < s.tasks.size() && !s.shared.stop)) return false; // Slice spent between subtrees
+    result = SharedResult(s.shared);
+    done = true;
+    search.reset();
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef KILLER_SOLVER_H
+#define KILLER_SOLVER_H
+
+#include "KillerPuzzle.h"
+#include <memory>
+
+// Returned by SolveKiller when the node budget ran out before the search finished
+const int SOLVE_ABORTED = -1;
+
+// Backtracking solver (bitmask candidates, fewest-candidates-first, cage sum bounds).
+// Counts solutions up to 'limit' and copies the first one into 'solution' (81 digits) if non-null.
+// A nodeBudget of 0 means unlimited.
+// NOTE: Cages may repeat digits (the generator grows them freely), so only the sum is enforced.
+int SolveKiller(const KillerPuzzle& puzzle, int limit, uint8_t* solution, long long nodeBudget = 0);
+
+// Same search split across threads, for uniqueness proofs of large-cage puzzles.
+// The tree is cut into a fixed set of subtrees (independent of 'threads'), dealt to
+// per-worker deques; idle workers steal. All workers stop once 'limit' solutions are found.
+// The count is reproducible; the copied solution is the one from the earliest subtree that
+// reported one, so it is exactly reproducible whenever the puzzle is unique.
+// nodeBudget is split evenly over the subtrees, each stopping on its own share, so whether
+// the search aborts is reproducible too (a lopsided tree can abort where SolveKiller would
+// not; budgeted checks that must match the sequential search should call SolveKiller).
+// Workers run on the JobSystem: threads <= 0 uses all of them (plus the caller). With no job
+// workers and no budget this is SolveKiller; with a budget the split is kept, so the verdict
+// is the same with or without workers. Used for the seed pool's uniqueness proofs.
+int SolveKillerParallel(const KillerPuzzle& puzzle, int limit, uint8_t* solution, long long nodeBudget = 0, int threads = 0);
+
+// Uniqueness proof run a slice at a time, for builds without job workers: the same subtrees
+// and budget as SolveKillerParallel(puzzle, 2, nullptr, nodeBudget), searched in order, and
+// the search pauses after 'sliceNodes' nodes and carries on from there on the next Step.
+class KillerProof {
+public:
+    KillerProof();
+    ~KillerProof();
+
+    void Start(const KillerPuzzle& puzzle, long long nodeBudget);
+    bool Step(long long sliceNodes); // True once Result() is known
+    int Result() const { return result; } // Solutions found (up to 2) or SOLVE_ABORTED
+
+private:
+    struct Search;
+    std::unique_ptr<Search> search;
+    bool done = true;
+    int result = 0;
+};
+
+#endif
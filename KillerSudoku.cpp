@@ -1,16 +1,45 @@
 #include "KillerSudoku.h"
+#include "KillerSolver.h"
+#include "PuzzleCode.h"
+#include "PuzzleFingerprint.h"
+#include "PuzzleTransform.h"
+#include "PlayerStats.h"
+#include "Telemetry.h"
+#include "FrameWatchdog.h"
+#include "InputLatency.h"
+#include "GameInput.h"
+#include "EffectQuality.h"
+#include "AudioFeedback.h"
+#include "UiScreen.h"
+#include "JobSystem.h"
 #include <algorithm>
 #include <random>
 #include <set>
 #include <cstdio>
 #include <cmath>
 #include "js_interop.h"
-#include <iostream>
 
 // Constants
 const int CELL_SIZE = 50;
 const int GRID_OFFSET_X = 175; // Center horizontally(ish)
 const int GRID_OFFSET_Y = 50;
+const int PAD_X = 645;           // Digit pad, right of the grid: touch screens have no keyboard
+const int PAD_Y = 150;
+const int PAD_KEY_SIZE = 44;
+const int PAD_GAP = 6;
+const int PAD_ERASE = 9;         // Pad keys 0-8 enter digits 1-9
+const int PAD_KEYS = 10;
+const char* SUDOKU_SNAPSHOT_FILE = "sudoku.sav";
+const uint16_t SUDOKU_SNAPSHOT_VERSION = 3;
+const int MAX_FRESH_ATTEMPTS = 8; // Derivations allowed to dodge a recently played board
+const int MAX_GENERATE_ATTEMPTS = 32; // Candidates tried for a unique, fresh puzzle before serving one unverified
+const long long SHARED_SOLVE_BUDGET = 5000000; // Nodes; a corrupt code must not hang the page
+const char* SEED_POOL_FILE = "seeds.bin";
+const uint16_t SEED_POOL_VERSION = 1;
+const size_t SEED_POOL_SIZE = 8; // Per difficulty
+const long long SEED_VERIFY_BUDGET = 1000000; // Nodes, split over the subtrees; no generated puzzle has come close
+const long long PROOF_SLICE_NODES = 500;      // Per menu frame without job workers (a few ms)
+const long long GENERATE_SLICE_NODES = 3000;  // Per frame while the player waits on "Generating puzzle..."
 
 // Pastel colors for cages
 const Color CAGE_COLORS[] = {
@@ -21,25 +50,122 @@ const Color CAGE_COLORS[] = {
 void KillerSudokuGame::Init() {
     isActive = false;
     selectedIndex = -1;
+    recentLoaded = false;
+    seedsLoaded = false;
+    seedJobRunning = false;
+    candidateStepped = false;
+    generating = false;
+    lastStartGenerated = false;
+    verified = false;
+}
+
+void KillerSudokuGame::Open(bool canResume) {
+    if (!canResume || !LoadSnapshot()) StartGame(S_MEDIUM);
 }
 
 void KillerSudokuGame::StartGame(SudokuDifficulty diff) {
     isActive = true;
     isComplete = false;
+    difficulty = diff;
     score = 0;
-    timer = 0;
-    timeAccumulator = 0.0;
+    leaderboardRank = 0;
+    finishMs = 0.0;
     selectedIndex = -1;
+    Telemetry::Get().Record(TELE_SUDOKU_START, diff);
     // seed RNG once
     std::random_device rd;
     rng.seed(rd());
 
-    std::cout << "--- START GAME 1: Before Diagonal Fill ---\n"; // Use the provided JsLog or a simple printf
+    // Fast path: disguise a verified seed, no generation or solving on the click
+    SolvedPuzzle derived;
+    lastStartGenerated = false;
+    if (PickSeed(diff, derived)) {
+        SetupFromPuzzle(derived.puzzle, derived.solution);
+        verified = true;
+        MarkPlayed(derived.puzzle);
+        shareCode = EncodeKillerCode(derived.puzzle, difficulty);
+        return;
+    }
 
-    // 1. Generate a valid full Sudoku grid
+    // Pool empty: generate and verify candidates until one will do, showing an empty board meanwhile
+    lastStartGenerated = true;
+    generateAttempts = 0;
     ClearGrid();
+    shareCode.clear();
+    clock.Reset();
+    StartGenerating();
+}
+
+void KillerSudokuGame::StartGenerating() {
+    StartCandidate(difficulty);
+    generating = true;
+    generateAttempts++;
+}
+
+// Once a candidate's proof is done: sets it up, or tries another if it is not unique or the
+// player has seen it recently (or a symmetric copy of it). After MAX_GENERATE_ATTEMPTS the
+// last one is served as it is, marked unverified unless it was proven.
+void KillerSudokuGame::CollectGenerated() {
+    SeedCandidate candidate;
+    if (!PollCandidate(GENERATE_SLICE_NODES, candidate)) return;
+    generating = false;
+    bool fresh = !IsRecentlyPlayed(FingerprintKiller(candidate.seed.puzzle));
+    if (!(candidate.unique && fresh) && generateAttempts < MAX_GENERATE_ATTEMPTS) {
+        StartGenerating();
+        return;
+    }
+    verified = candidate.unique;
+    if (!verified) printf("No unique puzzle in %d attempts, serving an unverified one\n", generateAttempts);
+    if (verified && fresh) AddSeed(candidate); // Stocks the pool for the next game too
+    MarkPlayed(candidate.seed.puzzle);
+    SetupFromPuzzle(candidate.seed.puzzle, candidate.seed.solution); // Generation time is not play time
+    shareCode = EncodeKillerCode(candidate.seed.puzzle, difficulty);
+}
 
-    std::cout << "--- START GAME 2: Before Full Solution Generation ---\n";
+// --- Candidates: generate, then prove unique ---
+// The generator does not guarantee a unique solution (most hard puzzles have several), so only
+// proven candidates are served as verified or become seeds. With job workers both steps are a
+// job and the proof is split over the workers (SolveKillerParallel; its per-subtree budget gives
+// the same verdict on any thread count). Without, as in the single-threaded web build where a
+// job would run inline in this frame, KillerProof runs the same search a slice of nodes per poll.
+void KillerSudokuGame::StartCandidate(SudokuDifficulty diff) {
+    std::random_device rd;
+    uint32_t rngSeed = rd();
+    candidateStepped = JobSystem::Get().WorkerCount() == 0;
+    if (candidateStepped) {
+        steppedCandidate.seed = GenerateSolved(diff, rngSeed); // Well under a millisecond
+        steppedCandidate.difficulty = diff;
+        steppedCandidate.unique = false;
+        seedProof.Start(steppedCandidate.seed.puzzle, SEED_VERIFY_BUDGET);
+        return;
+    }
+    pendingSeed = Async([diff, rngSeed]() { return GenerateSolved(diff, rngSeed); })
+        .Then([diff](const SolvedPuzzle& seed) {
+            SeedCandidate candidate;
+            candidate.seed = seed;
+            candidate.difficulty = diff;
+            candidate.unique = SolveKillerParallel(seed.puzzle, 2, nullptr, SEED_VERIFY_BUDGET) == 1;
+            return candidate;
+        });
+}
+
+bool KillerSudokuGame::PollCandidate(long long sliceNodes, SeedCandidate& out) {
+    if (candidateStepped) {
+        if (!seedProof.Step(sliceNodes)) return false;
+        out = steppedCandidate;
+        out.unique = seedProof.Result() == 1;
+        return true;
+    }
+    if (!pendingSeed.IsReady()) return false;
+    out = pendingSeed.Wait();
+    return true;
+}
+
+void KillerSudokuGame::GeneratePuzzle(SudokuDifficulty diff) {
+    std::random_device rd;
+
+    // 1. Generate a valid full Sudoku grid
+    ClearGrid();
 
     // Fill diagonal 3x3 boxes first (independent of each other) to speed up solver
     std::mt19937 g(rd());
@@ -58,11 +184,9 @@ void KillerSudokuGame::StartGame(SudokuDifficulty diff) {
     }
     
     GenerateFullSolution(0);
-    std::cout << "--- START GAME 3: Before Cage Generation ---\n"; // If the crash happens before this, look at GenerateFullSolution
 
     // 2. Generate Cages based on the solution
     GenerateCages(diff);
-    std::cout << "--- START GAME 4: Before Final Clear/Setup ---\n"; // If the crash happens here, look at GenerateCages
 
     // 3. Clear inputs for the player
     for (int i = 0; i < 81; i++) {
@@ -83,6 +207,194 @@ void KillerSudokuGame::StartGame(SudokuDifficulty diff) {
     }
 }
 
+bool KillerSudokuGame::IsRecentlyPlayed(uint64_t key) {
+    // Loaded on first use: on the web, save storage is only ready after startup
+    if (!recentLoaded) {
+        recentPuzzles.Load();
+        recentLoaded = true;
+    }
+    return recentPuzzles.Contains(key);
+}
+
+// Under both keys: the fingerprint keeps new puzzles new (generation and the seed pool skip a
+// class played recently), the exact hash keeps a seed's derivations from repeating a board
+void KillerSudokuGame::MarkPlayed(const KillerPuzzle& puzzle) {
+    uint64_t keys[2] = { FingerprintKiller(puzzle), HashKiller(puzzle) };
+    bool added = false;
+    for (uint64_t key : keys) {
+        if (IsRecentlyPlayed(key)) continue;
+        recentPuzzles.Insert(key);
+        added = true;
+    }
+    if (added) recentPuzzles.Save();
+}
+
+// --- Seed pool ---
+// A random seed, disguised (DeriveKiller keeps uniqueness). Seeds are kept: every derivation
+// shares the seed's fingerprint, so only the exact board is checked against recent games.
+bool KillerSudokuGame::PickSeed(SudokuDifficulty diff, SolvedPuzzle& derived) {
+    if (!seedsLoaded) LoadSeedPool();
+    const std::vector<SolvedPuzzle>& pool = seedPool[diff];
+    if (pool.empty()) return false;
+    ProfileSpan span("Derive from seed");
+    for (int attempt = 0; attempt < MAX_FRESH_ATTEMPTS; attempt++) {
+        derived = DeriveKiller(pool[rng() % pool.size()], rng);
+        if (!IsRecentlyPlayed(HashKiller(derived.puzzle))) break;
+    }
+    return true;
+}
+
+void KillerSudokuGame::AddSeed(const SeedCandidate& candidate) {
+    if (!seedsLoaded) LoadSeedPool();
+    std::vector<SolvedPuzzle>& pool = seedPool[candidate.difficulty];
+    if (pool.size() >= SEED_POOL_SIZE) return;
+    pool.push_back(candidate.seed);
+    SaveSeedPool();
+}
+
+// Runs on a job worker: a scratch instance generates, so no game's grid is touched
+SolvedPuzzle KillerSudokuGame::GenerateSolved(SudokuDifficulty diff, uint32_t rngSeed) {
+    KillerSudokuGame generator;
+    generator.rng.seed(rngSeed);
+    generator.GeneratePuzzle(diff);
+    SolvedPuzzle result;
+    result.puzzle = generator.ExportPuzzle();
+    for (int i = 0; i < 81; i++) result.solution[i] = (uint8_t)generator.grid[i].value;
+    return result;
+}
+
+void KillerSudokuGame::RefillSeedPool() {
+    if (isActive) return;
+    if (!seedsLoaded) LoadSeedPool();
+
+    // Publish the finished candidate here, on the main thread, which owns the pool and its file
+    if (seedJobRunning) {
+        SeedCandidate candidate;
+        if (!PollCandidate(PROOF_SLICE_NODES, candidate)) return;
+        seedJobRunning = false;
+        if (!candidate.unique || IsRecentlyPlayed(FingerprintKiller(candidate.seed.puzzle))) return;
+        AddSeed(candidate);
+        return;
+    }
+
+    SudokuDifficulty diff = (seedPool[S_MEDIUM].size() <= seedPool[S_HARD].size()) ? S_MEDIUM : S_HARD;
+    if (seedPool[diff].size() >= SEED_POOL_SIZE) return;
+    StartCandidate(diff);
+    seedJobRunning = true;
+}
+
+// Payload: per difficulty, count then count x (cageCount, cageOf[81], cageSum[cageCount], given[81], solution[81])
+void KillerSudokuGame::LoadSeedPool() {
+    // Loaded on first use, like the recent filter
+    seedsLoaded = true;
+    seedPool[S_MEDIUM].clear();
+    seedPool[S_HARD].clear();
+
+    uint16_t version = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadSnapshotFile(SEED_POOL_FILE, SNAP_SEEDS, version, payload)) return;
+    if (version != SEED_POOL_VERSION) return;
+
+    ByteReader in(payload.data(), payload.size());
+    std::vector<SolvedPuzzle> loaded[2];
+    for (int d = 0; d < 2; d++) {
+        int count = in.U8();
+        if (count > (int)SEED_POOL_SIZE) return;
+        for (int k = 0; k < count && in.Ok(); k++) {
+            SolvedPuzzle seed;
+            seed.puzzle.cageCount = in.U8();
+            if (seed.puzzle.cageCount < 1 || seed.puzzle.cageCount > 81) return;
+            in.Bytes(seed.puzzle.cageOf, 81);
+            in.Bytes(seed.puzzle.cageSum, seed.puzzle.cageCount);
+            in.Bytes(seed.puzzle.given, 81);
+            in.Bytes(seed.solution, 81);
+            for (int i = 0; i < 81; i++) {
+                if (seed.puzzle.cageOf[i] >= seed.puzzle.cageCount || seed.solution[i] < 1 || seed.solution[i] > 9) return;
+            }
+            loaded[d].push_back(seed);
+        }
+    }
+    if (!in.Ok() || !in.AtEnd()) return;
+
+    seedPool[S_MEDIUM].swap(loaded[S_MEDIUM]);
+    seedPool[S_HARD].swap(loaded[S_HARD]);
+}
+
+void KillerSudokuGame::SaveSeedPool() {
+    ByteWriter out;
+    for (int d = 0; d < 2; d++) {
+        out.U8((uint8_t)seedPool[d].size());
+        for (const auto& seed : seedPool[d]) {
+            out.U8((uint8_t)seed.puzzle.cageCount);
+            out.Bytes(seed.puzzle.cageOf, 81);
+            out.Bytes(seed.puzzle.cageSum, seed.puzzle.cageCount);
+            out.Bytes(seed.puzzle.given, 81);
+            out.Bytes(seed.solution, 81);
+        }
+    }
+    WriteSnapshotFile(SEED_POOL_FILE, SNAP_SEEDS, SEED_POOL_VERSION, out);
+}
+
+bool KillerSudokuGame::StartFromCode(const std::string& code) {
+    KillerPuzzle puzzle;
+    int diff = 0;
+    if (!DecodeKillerCode(code, puzzle, diff) || diff > S_HARD) return false;
+
+    // The code carries no solution; re-derive it, and whether it is the only one. A search that
+    // ran out of budget after its first solution still leaves a playable, unproven board.
+    ProfileSpan span("Solve shared code");
+    uint8_t solution[81] = {};
+    int found = SolveKiller(puzzle, 2, solution, SHARED_SOLVE_BUDGET);
+    if (found == 0 || solution[0] == 0) return false;
+
+    difficulty = (SudokuDifficulty)diff;
+    SetupFromPuzzle(puzzle, solution);
+    verified = found == 1;
+    shareCode = code;
+    MarkPlayed(puzzle); // Shared on purpose, but don't generate it again later
+    Telemetry::Get().Record(TELE_SUDOKU_START, diff);
+    return true;
+}
+
+void KillerSudokuGame::SetupFromPuzzle(const KillerPuzzle& puzzle, const uint8_t* solution) {
+    ClearGrid();
+    for (int c = 0; c < puzzle.cageCount; c++) {
+        Cage cage;
+        cage.id = c;
+        cage.targetSum = puzzle.cageSum[c];
+        cage.color = CAGE_COLORS[c % 6];
+        cages.push_back(cage);
+    }
+    for (int i = 0; i < 81; i++) {
+        grid[i].value = solution[i];
+        grid[i].cageID = puzzle.cageOf[i];
+        grid[i].isFixed = puzzle.given[i] != 0;
+        grid[i].currentInput = puzzle.given[i];
+        cages[puzzle.cageOf[i]].cellIndices.push_back(i);
+    }
+
+    isActive = true;
+    isComplete = false;
+    generating = false; // A generation still running is superseded
+    score = 0;
+    leaderboardRank = 0;
+    finishMs = 0.0;
+    selectedIndex = -1;
+    clock.Reset();
+}
+
+KillerPuzzle KillerSudokuGame::ExportPuzzle() const {
+    KillerPuzzle p;
+    p.cageCount = (int)cages.size();
+    for (const auto& cage : cages) p.cageSum[cage.id] = (uint8_t)cage.targetSum;
+    for (int i = 0; i < 81; i++) {
+        p.cageOf[i] = (uint8_t)grid[i].cageID;
+        p.given[i] = grid[i].isFixed ? (uint8_t)grid[i].value : 0;
+    }
+    NormalizeCageOrder(p);
+    return p;
+}
+
 void KillerSudokuGame::ClearGrid() {
     for (int i = 0; i < 81; i++) {
         grid[i].value = 0;
@@ -190,58 +502,84 @@ void KillerSudokuGame::GenerateCages(SudokuDifficulty diff) {
     }
 }
 
+// Grid cell under a layout point, -1 off the grid
+static int CellAt(Vector2 at) {
+    int gridX = (int)floorf((at.x - GRID_OFFSET_X) / CELL_SIZE);
+    int gridY = (int)floorf((at.y - GRID_OFFSET_Y) / CELL_SIZE);
+    if (gridX < 0 || gridX >= 9 || gridY < 0 || gridY >= 9) return -1;
+    return gridY * 9 + gridX;
+}
+
+static Rectangle PadKeyRect(int key) {
+    const float step = PAD_KEY_SIZE + PAD_GAP;
+    if (key == PAD_ERASE) return { (float)PAD_X, PAD_Y + 3 * step, 3 * step - PAD_GAP, (float)PAD_KEY_SIZE };
+    return { PAD_X + (key % 3) * step, PAD_Y + (key / 3) * step, (float)PAD_KEY_SIZE, (float)PAD_KEY_SIZE };
+}
+
+// Pad keys are buttons 0-9 (their key numbers), then MENU
+void KillerSudokuGame::BuildScreen() {
+    const UiStyle digitStyle = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKBLUE, 1, 30 };
+    const UiStyle eraseStyle = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKBLUE, 1, 20 };
+    const UiStyle menuStyle = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKGRAY, 1, 16 };
+    static const char* DIGIT_LABELS[] = { "1", "2", "3", "4", "5", "6", "7", "8", "9" };
+    for (int key = 0; key < PAD_KEYS; key++) {
+        if (key == PAD_ERASE) screen.AddButton(PadKeyRect(key), "ERASE", eraseStyle);
+        else screen.AddButton(PadKeyRect(key), DIGIT_LABELS[key], digitStyle);
+    }
+    btnMenu = screen.AddButton({ 20, 550, 80, 30 }, "MENU", menuStyle);
+    screen.SetIcon(btnMenu, SPRITE_ICON_MENU);
+}
+
 void KillerSudokuGame::Update() {
     if (!isActive) return;
+    if (!screen.IsBuilt()) BuildScreen();
+    screen.Update();
+    if (screen.Clicked(btnMenu)) {
+        ReturnToMenu(); // Saves an unfinished puzzle
+        return;
+    }
+    if (generating) {
+        CollectGenerated(); // No input until the board is there
+        return;
+    }
     if (isComplete) return; // Stop input if won
 
-    // Timer
-    timeAccumulator += GetFrameTime();
-    if (timeAccumulator >= 1.0) {
-        timer++;
-        timeAccumulator -= 1.0;
+    // Share: copy this puzzle's code
+    if ((InputKeyDown(KEY_LEFT_CONTROL) || InputKeyDown(KEY_RIGHT_CONTROL)) && InputKeyPressed(KEY_C)) {
+        CopyToClipboard(shareCode.c_str());
+        printf("Puzzle code: %s\n", shareCode.c_str());
     }
 
-    // Input Handling
-    Vector2 mousePos = GetMousePosition();
-    
-    // Grid Selection
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        selectedIndex = -1;
-        int gridX = (mousePos.x - GRID_OFFSET_X) / CELL_SIZE;
-        int gridY = (mousePos.y - GRID_OFFSET_Y) / CELL_SIZE;
-        
-        if (gridX >= 0 && gridX < 9 && gridY >= 0 && gridY < 9) {
-            int idx = gridY * 9 + gridX;
-            if (!grid[idx].isFixed) {
-                selectedIndex = idx;
-            }
+    // Pointer: every press this frame, each finger's on a touch screen. The pad enters into
+    // the selected cell; anywhere else selects the cell there, or nothing.
+    for (int p = 0; p < InputPressCount() && !isComplete; p++) {
+        int button = screen.PressTarget(p);
+        if (button >= 0) {
+            if (button >= PAD_KEYS || selectedIndex == -1) continue;
+            if (button == PAD_ERASE) EraseDigit();
+            else EnterDigit(button + 1);
+            continue;
         }
+        int cell = CellAt(InputPress(p));
+        selectedIndex = (cell >= 0 && !grid[cell].isFixed) ? cell : -1;
+    }
+    // A finger dragged from the grid takes the selection along with it
+    for (int t = 0; t < InputTouchCount(); t++) {
+        const TouchPoint& touch = InputTouch(t);
+        if (!touch.dragging || CellAt(touch.start) < 0) continue;
+        int cell = CellAt(touch.position);
+        if (cell >= 0 && !grid[cell].isFixed) selectedIndex = cell;
     }
+    if (isComplete) return;
 
     // Keyboard Input
-    int key = GetKeyPressed();
+    int key = InputNextKey();
     if (selectedIndex != -1) {
         int num = -1;
         if (key >= KEY_ONE && key <= KEY_NINE) num = key - KEY_ONE + 1;
         if (key >= KEY_KP_1 && key <= KEY_KP_9) num = key - KEY_KP_1 + 1;
-        
-        if (num != -1) {
-            grid[selectedIndex].currentInput = num;
-            CheckErrors();
-            if (CheckWinCondition()) {
-                isComplete = true;
-                score = (10000 / (timer + 1)); // Simple score based on time
-
-                // Save result once (High-is-better -> sortOrder = 1)
-                SaveScoreToBrowser(score, 1);
-            }
-        }
-
-        
-        if (key == KEY_BACKSPACE || key == KEY_DELETE) {
-            grid[selectedIndex].currentInput = 0;
-            grid[selectedIndex].isError = false;
-        }
+        if (num != -1) EnterDigit(num);
+        if (key == KEY_BACKSPACE || key == KEY_DELETE) EraseDigit();
         
         // Arrows navigation
         if (key == KEY_UP && selectedIndex >= 9) selectedIndex -= 9;
@@ -251,53 +589,121 @@ void KillerSudokuGame::Update() {
     }
 }
 
+// Into the selected cell, from a key or the pad
+void KillerSudokuGame::EnterDigit(int num) {
+    grid[selectedIndex].currentInput = num;
+    CheckErrors();
+    Telemetry::Get().Record(TELE_DIGIT_ENTRY, num, selectedIndex);
+    InputLatency::Get().Respond(LAT_DIGIT_ENTRY, InputLatency::Get().InputTime());
+    if (grid[selectedIndex].isError) Telemetry::Get().Record(TELE_CONFLICT, num, selectedIndex);
+    bool won = CheckWinCondition();
+    AudioFeedback::Get().Play(won ? SOUND_COMPLETE : grid[selectedIndex].isError ? SOUND_ERROR : SOUND_DIGIT);
+    if (won) {
+        isComplete = true;
+        finishMs = clock.ElapsedAt(InputLatency::Get().InputTime()); // When the digit was typed
+        clock.Stop();
+        int seconds = (int)(finishMs / 1000.0);
+        score = (10000 / (seconds + 1)); // Simple score based on time; ties broken by finishMs
+
+        // Save result once (High-is-better -> sortOrder = 1)
+        leaderboardRank = SaveScoreToBrowser(score, 1, (int)finishMs);
+        Telemetry::Get().Record(TELE_SUDOKU_WIN, 0, score);
+        PlayerStats::Get().RecordSudokuGame(difficulty, seconds, score);
+        ClearSnapshot();
+    }
+}
+
+void KillerSudokuGame::EraseDigit() {
+    grid[selectedIndex].currentInput = 0;
+    grid[selectedIndex].isError = false;
+    Telemetry::Get().Record(TELE_DIGIT_ENTRY, 0, selectedIndex);
+}
+
+// Checks the rules, not grid[].value: a puzzle may have more than one solution (a shared code
+// only carries the puzzle), and any grid that keeps the rules wins
 void KillerSudokuGame::CheckErrors() {
-    // Basic standard sudoku check (duplicates in row/col/box)
-    // In a real game, you might not show errors immediately, but for casual play it's nice.
     for (int i = 0; i < 81; i++) grid[i].isError = false;
 
-    // We only check against the pre-generated solution for simplicity here
-    // But strictly we should check game rules. 
+    // A digit twice in a row, column or box marks both cells
     for (int i = 0; i < 81; i++) {
-        if (grid[i].currentInput != 0 && grid[i].currentInput != grid[i].value) {
-            grid[i].isError = true;
+        if (grid[i].currentInput == 0) continue;
+        int row = i / 9, col = i % 9, box = (row / 3) * 3 + col / 3;
+        for (int j = i + 1; j < 81; j++) {
+            if (grid[j].currentInput != grid[i].currentInput) continue;
+            int r = j / 9, c = j % 9;
+            if (r == row || c == col || (r / 3) * 3 + c / 3 == box) {
+                grid[i].isError = true;
+                grid[j].isError = true;
+            }
+        }
+    }
+
+    // A cage over its sum, or full and short of it, marks its cells. Cages may repeat digits
+    // (see KillerSolver.h), so the sum is the only cage rule.
+    for (const auto& cage : cages) {
+        int sum = 0, filled = 0;
+        for (int cIdx : cage.cellIndices) {
+            sum += grid[cIdx].currentInput;
+            if (grid[cIdx].currentInput != 0) filled++;
+        }
+        if (sum <= cage.targetSum && (filled < (int)cage.cellIndices.size() || sum == cage.targetSum)) continue;
+        for (int cIdx : cage.cellIndices) {
+            if (grid[cIdx].currentInput != 0) grid[cIdx].isError = true;
         }
     }
 }
 
+// After CheckErrors: a full board with no broken rule
 bool KillerSudokuGame::CheckWinCondition() {
     for (int i = 0; i < 81; i++) {
-        if (grid[i].currentInput != grid[i].value) return false;
+        if (grid[i].currentInput == 0 || grid[i].isError) return false;
     }
     return true;
 }
 
-void KillerSudokuGame::Draw() {
-    if (!isActive) return;
-
+// Also draws the frame MENU was clicked in: the board stays up until main.cpp leaves the game
+void KillerSudokuGame::Draw(float /*alpha*/) {
     DrawBoard();
+    bool padEnabled = selectedIndex != -1 && !isComplete;
+    for (int key = 0; key < PAD_KEYS; key++) screen.SetEnabled(key, padEnabled);
+    screen.Draw();
     
     // HUD
-    DrawText(TextFormat("Time: %02i:%02i", timer/60, timer%60), 20, 20, 20, DARKGRAY);
+    if (isComplete) {
+        int ms = (int)finishMs;
+        DrawText(TextFormat("Time: %02i:%02i.%03i", ms / 60000, ms / 1000 % 60, ms % 1000), 20, 20, 20, DARKGRAY);
+    } else {
+        int seconds = clock.Seconds();
+        DrawText(TextFormat("Time: %02i:%02i", seconds / 60, seconds % 60), 20, 20, 20, DARKGRAY);
+    }
     
+    if (generating) {
+        DrawText("Generating puzzle...", 300, 15, 20, GRAY);
+    } else if (!verified && !isComplete) {
+        DrawText("Unverified: may have several solutions", 300, 15, 20, MAROON);
+    }
     if (isComplete) {
         DrawText("PUZZLE SOLVED!", 300, 10, 30, GOLD);
         DrawText(TextFormat("Score: %i", score), 320, 45, 20, DARKGREEN);
+        if (leaderboardRank > 0) DrawText(TextFormat("Leaderboard rank: #%i", leaderboardRank), 440, 45, 20, GOLD);
     }
     
-    // Back Button
-    Rectangle btnBack = { 20, 550, 80, 30 };
-    DrawRectangleRec(btnBack, LIGHTGRAY);
-    DrawRectangleLinesEx(btnBack, 1, DARKGRAY);
-    DrawText("MENU", 35, 558, 16, DARKGRAY);
-    
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), btnBack)) {
-        ReturnToMenu();
-    }
+    // Share code
+    DrawText(TextFormat("Code: %s", shareCode.c_str()), 120, 558, 10, GRAY);
+    DrawText("Ctrl+C to copy", 120, 572, 10, LIGHTGRAY);
+}
+
+// A cage tint pre-blended over the board background, for devices short on fill rate
+static Color OpaqueTint(Color tint) {
+    auto mix = [&](unsigned char over, unsigned char under) {
+        return (unsigned char)((over * tint.a + under * (255 - tint.a)) / 255);
+    };
+    return { mix(tint.r, RAYWHITE.r), mix(tint.g, RAYWHITE.g), mix(tint.b, RAYWHITE.b), 255 };
 }
 
 void KillerSudokuGame::DrawBoard() {
     // 1. Draw Cages (Backgrounds)
+    bool blended = EffectQuality::Get().BlendedCageTints();
     for (int i = 0; i < 81; i++) {
         int r = i / 9;
         int c = i % 9;
@@ -307,7 +713,7 @@ void KillerSudokuGame::DrawBoard() {
         // Find cage
         for (const auto& cage : cages) {
             if (cage.id == grid[i].cageID) {
-                DrawRectangle(x, y, CELL_SIZE, CELL_SIZE, cage.color);
+                DrawRectangle(x, y, CELL_SIZE, CELL_SIZE, blended ? cage.color : OpaqueTint(cage.color));
                 break;
             }
         }
@@ -389,9 +795,143 @@ void KillerSudokuGame::DrawBoard() {
 }
 
 void KillerSudokuGame::ReturnToMenu() {
+    SaveSnapshot(); // Keep an unfinished puzzle so the next visit resumes it
+    if (!isComplete && !generating) Telemetry::Get().Record(TELE_SUDOKU_QUIT, 0, clock.Seconds());
     isActive = false;
 }
 
+const char* KillerSudokuGame::DescribeState() const {
+    if (!isActive) return "inactive";
+    if (generating) return TextFormat("generating (attempt %d)", generateAttempts);
+    int filled = 0;
+    for (int i = 0; i < 81; i++) filled += grid[i].currentInput != 0;
+    return TextFormat("%s, %s, %d/81 filled%s%s", difficulty == S_HARD ? "hard" : "medium",
+                      isComplete ? "solved" : "playing", filled, lastStartGenerated ? ", generated" : ", from seed pool",
+                      verified ? "" : ", unverified");
+}
+
 bool KillerSudokuGame::IsActive() {
     return isActive;
+}
+
+// --- Save/Resume ---
+// Payload v1: grid[81] x (value, input, cageID, flags), cages x (sum, count, cells...),
+// then timer (whole seconds + fraction), selectedIndex. v2 appends the difficulty, v3 whether
+// the puzzle was proven unique (older saves load as unverified).
+void KillerSudokuGame::SaveSnapshot() {
+    if (!HasGameInProgress()) return;
+
+    ByteWriter& out = snapshotBuffer;
+    out.Clear();
+    for (int i = 0; i < 81; i++) {
+        out.U8((uint8_t)grid[i].value);
+        out.U8((uint8_t)grid[i].currentInput);
+        out.U8((uint8_t)grid[i].cageID);
+        out.U8((grid[i].isFixed ? 1 : 0) | (grid[i].isError ? 2 : 0));
+    }
+    out.U8((uint8_t)cages.size());
+    for (const auto& cage : cages) {
+        out.U8((uint8_t)cage.targetSum);
+        out.U8((uint8_t)cage.cellIndices.size());
+        for (int idx : cage.cellIndices) out.U8((uint8_t)idx);
+    }
+    double elapsedMs = clock.ElapsedMs();
+    out.I32((int)(elapsedMs / 1000.0));
+    out.F64(fmod(elapsedMs, 1000.0) / 1000.0);
+    out.I32(selectedIndex);
+    out.U8((uint8_t)difficulty);
+    out.U8(verified ? 1 : 0);
+
+    WriteSnapshotFile(SUDOKU_SNAPSHOT_FILE, SNAP_SUDOKU, SUDOKU_SNAPSHOT_VERSION, out);
+}
+
+bool KillerSudokuGame::LoadSnapshot() {
+    uint16_t version = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadSnapshotFile(SUDOKU_SNAPSHOT_FILE, SNAP_SUDOKU, version, payload)) return false;
+    if (version < 1 || version > SUDOKU_SNAPSHOT_VERSION) return false;
+
+    ByteReader in(payload.data(), payload.size());
+    SudokuCell loaded[81];
+    for (int i = 0; i < 81; i++) {
+        loaded[i].value = in.U8();
+        loaded[i].currentInput = in.U8();
+        loaded[i].cageID = in.U8();
+        uint8_t flags = in.U8();
+        loaded[i].isFixed = (flags & 1) != 0;
+        loaded[i].isError = (flags & 2) != 0;
+        if (loaded[i].value < 1 || loaded[i].value > 9 || loaded[i].currentInput > 9) return false;
+    }
+
+    std::vector<Cage> loadedCages(in.U8());
+    for (size_t c = 0; c < loadedCages.size(); c++) {
+        Cage& cage = loadedCages[c];
+        cage.id = (int)c;
+        cage.color = CAGE_COLORS[cage.id % 6];
+        cage.targetSum = in.U8();
+        int count = in.U8();
+        for (int k = 0; k < count; k++) {
+            int idx = in.U8();
+            if (idx >= 81 || loaded[idx].cageID != cage.id) return false;
+            cage.cellIndices.push_back(idx);
+        }
+    }
+    for (int i = 0; i < 81; i++) {
+        if (loaded[i].cageID >= (int)loadedCages.size()) return false;
+    }
+
+    int loadedTimer = in.I32();
+    double loadedAccumulator = in.F64();
+    int loadedSelected = in.I32();
+    int loadedDifficulty = (version >= 2) ? (int)in.U8() : (int)S_MEDIUM;
+    bool loadedVerified = (version >= 3) ? in.U8() != 0 : false;
+    if (!in.Ok() || !in.AtEnd() || loadedSelected < -1 || loadedSelected >= 81) return false;
+    if (loadedDifficulty > S_HARD) return false;
+
+    // Everything validated, commit
+    for (int i = 0; i < 81; i++) grid[i] = loaded[i];
+    cages.swap(loadedCages);
+    clock.Reset(loadedTimer * 1000.0 + loadedAccumulator * 1000.0);
+    finishMs = 0.0;
+    selectedIndex = loadedSelected;
+    difficulty = (SudokuDifficulty)loadedDifficulty;
+    verified = loadedVerified;
+    score = 0;
+    leaderboardRank = 0;
+    isComplete = false;
+    isActive = true;
+    shareCode = EncodeKillerCode(ExportPuzzle(), difficulty);
+    return true;
+}
+
+void KillerSudokuGame::ClearSnapshot() {
+    DeleteSnapshotFile(SUDOKU_SNAPSHOT_FILE);
+}
+
+// --- Module entry (GameModule.h) ---
+// Menu idle work stocks the seed pool through an instance of its own, so the played game's
+// instance can be released on leaving. Creating a game drops the stocker: seeds.bin is then
+// the played instance's, and the next stocker reloads it from disk. A seed job still running
+// holds no pointer to the stocker; its result is just never collected.
+static KillerSudokuGame* seedStocker = nullptr;
+
+static GameModule* CreateKillerSudoku() {
+    delete seedStocker;
+    seedStocker = nullptr;
+    KillerSudokuGame* game = new KillerSudokuGame();
+    game->Init();
+    return game;
+}
+
+static void StockSeeds() {
+    if (!seedStocker) {
+        seedStocker = new KillerSudokuGame();
+        seedStocker->Init();
+    }
+    seedStocker->RefillSeedPool();
+}
+
+GAME_MODULE_EXPORT const GameModuleEntry* KillerSudokuEntry() {
+    static const GameModuleEntry entry = { CreateKillerSudoku, StockSeeds };
+    return &entry;
 }
\ No newline at end of file
@@ -2,6 +2,15 @@
 #define KILLER_SUDOKU_H
 
 #include "raylib.h"
+#include "Snapshot.h"
+#include "KillerPuzzle.h"
+#include "PuzzleFingerprint.h"
+#include "PuzzleTransform.h"
+#include "GameClock.h"
+#include "GameModule.h"
+#include "UiScreen.h"
+#include "JobSystem.h"
+#include "KillerSolver.h"
 #include <vector>
 #include <string>
 #include <random>
@@ -13,7 +22,7 @@ enum SudokuDifficulty {
 };
 
 struct SudokuCell {
-    int value;          // The correct solution value
+    int value;          // One solution (the generator's, or the solver's for a shared code); not used to judge input
     int currentInput;   // What the player typed (0 if empty)
     int cageID;         // ID to group cells
     bool isFixed;       // If true, player cannot change (rare in Killer, but good to have)
@@ -27,42 +36,103 @@ struct Cage {
     Color color; // Subtle background tint
 };
 
-class KillerSudokuGame {
+class KillerSudokuGame : public GameModule {
 public:
     void Init();
+    void Open(bool canResume) override;
     void StartGame(SudokuDifficulty diff);
-    void Update();
-    void Draw();
-    bool IsActive(); 
+    bool StartFromCode(const std::string& code) override; // Plays a shared puzzle, false if the code is invalid
+    void Update() override;
+    void Draw(float alpha) override;
+    bool IsActive() override;
     void ReturnToMenu();
 
     // Helper for main.cpp to get score
     int GetScore() const { return score; }
 
+    // Save/Resume (autosaved by main.cpp while a puzzle is in progress)
+    bool HasGameInProgress() const override { return isActive && !isComplete && !generating; }
+    void SaveSnapshot() override;
+    bool LoadSnapshot(); // Restores the saved puzzle and makes the game active
+    void ClearSnapshot();
+
+    // App hidden/minimized: the game clock stops counting
+    void SetPaused(bool paused) override { if (paused) clock.Pause(); else clock.Resume(); }
+
+    // Sharing
+    KillerPuzzle ExportPuzzle() const;
+    const std::string& GetShareCode() const { return shareCode; }
+
+    // Hitch reports: difficulty, progress and whether a puzzle had to be generated
+    const char* DescribeState() const override;
+
+    // Seed pool: verified-unique puzzles that StartGame turns into a fresh game instantly.
+    // Called every menu frame: works on one generate+verify candidate at a time (see
+    // StartCandidate) and adds its seed to the pool once it is done. Only while no game is active.
+    void RefillSeedPool();
+
 private:
     // Game State
     SudokuCell grid[81];
     std::vector<Cage> cages;
     int selectedIndex; // -1 if nothing selected
     int score;
-    int timer;
-    double timeAccumulator;
+    int leaderboardRank; // Of the winning score on the local leaderboard, natively; 0 on the web
+    GameClock clock;   // Starts once the puzzle is on screen, stopped by the winning digit
+    double finishMs;   // Time of the winning digit's input (tiebreak on the leaderboard)
     bool isComplete;
     bool isActive;
+    SudokuDifficulty difficulty;
+    std::string shareCode; // Encoded once per puzzle, drawn in the HUD
     std::mt19937 rng;
+    ByteWriter snapshotBuffer; // Reused between autosaves
+    RecentPuzzleFilter recentPuzzles;
+    bool recentLoaded;
+    std::vector<SolvedPuzzle> seedPool[2]; // Per difficulty, kept and derived again for each game
+    bool seedsLoaded;
+    struct SeedCandidate {
+        SolvedPuzzle seed;
+        SudokuDifficulty difficulty;
+        bool unique;
+    };
+    Future<SeedCandidate> pendingSeed; // The candidate's job, with job workers
+    KillerProof seedProof;             // Its proof run a slice per frame, without
+    SeedCandidate steppedCandidate;    // The puzzle seedProof is proving
+    bool candidateStepped;
+    bool seedJobRunning;     // RefillSeedPool has a candidate in progress
+    bool lastStartGenerated; // StartGame missed the seed pool and ran the generator
+    bool generating;         // Until Update collects a candidate; the board is empty meanwhile
+    int generateAttempts;
+    bool verified;           // Proven to have one solution; the HUD says when it is not
+    UiScreen screen;         // The input pad and MENU
+    int btnMenu;
 
-    
     // Generation Helpers
     void ClearGrid();
     bool GenerateFullSolution(int index);
     bool IsSafe(int index, int num);
+    void GeneratePuzzle(SudokuDifficulty diff); // Fills grid + cages (+ givens for medium)
+    static SolvedPuzzle GenerateSolved(SudokuDifficulty diff, uint32_t rngSeed); // Thread-safe
+    void StartGenerating();
+    void CollectGenerated();
+    void StartCandidate(SudokuDifficulty diff);
+    bool PollCandidate(long long sliceNodes, SeedCandidate& out); // True once the proof is done
     void GenerateCages(SudokuDifficulty diff);
+    void SetupFromPuzzle(const KillerPuzzle& puzzle, const uint8_t* solution);
+    bool IsRecentlyPlayed(uint64_t key); // FingerprintKiller or HashKiller
+    void MarkPlayed(const KillerPuzzle& puzzle);
+    bool PickSeed(SudokuDifficulty diff, SolvedPuzzle& derived);
+    void AddSeed(const SeedCandidate& candidate);
+    void LoadSeedPool();
+    void SaveSeedPool();
     
     // Gameplay Helpers
+    void EnterDigit(int num); // Into the selected cell (keyboard or the input pad)
+    void EraseDigit();
     void CheckErrors();
     bool CheckWinCondition();
     void DrawBoard();
-    void DrawInputPad();
+    void BuildScreen(); // Input pad (digits 1-9 and erase, right of the grid: entry without a keyboard) and MENU
 };
 
 #endif
\ No newline at end of file
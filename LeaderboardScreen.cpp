@@ -0,0 +1,79 @@
+#include "LeaderboardScreen.h"
+#include "GameInput.h"
+#include "VirtualScreen.h"
+#include "UiScreen.h"
+
+// Constants
+const char* BOARD_TITLES[BOARD_COUNT] = { "Memory (low is better)", "Killer Sudoku (high is better)" };
+
+LeaderboardScreen& LeaderboardScreen::Get() {
+    static LeaderboardScreen instance;
+    return instance;
+}
+
+void LeaderboardScreen::NoteScore(ScoreBoard board, int rank, int score, int elapsedMs) {
+    latest[board] = { rank, score, elapsedMs };
+}
+
+// --- Screen ---
+static UiScreen boardScreen;
+static int btnBack;
+
+// The boards only change when a game is won, never while this screen is up
+void LeaderboardScreen::Open() {
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        top[b] = ScoreDatabase::Get().TopK((ScoreBoard)b, ROWS);
+        counts[b] = ScoreDatabase::Get().Count((ScoreBoard)b);
+    }
+    active = true;
+}
+
+void LeaderboardScreen::Update() {
+    if (!boardScreen.IsBuilt()) {
+        btnBack = boardScreen.AddButton({ 20, 20, 100, 30 }, "BACK", UI_BACK_BUTTON);
+        boardScreen.SetIcon(btnBack, SPRITE_ICON_BACK);
+    }
+    boardScreen.Update();
+    if (boardScreen.Clicked(btnBack) || InputKeyPressed(KEY_ENTER)) {
+        active = false;
+    }
+}
+
+static const char* FormatTime(int elapsedMs) {
+    if (elapsedMs == SCORE_NO_TIME) return "";
+    return TextFormat("%i:%02i.%03i", elapsedMs / 60000, elapsedMs / 1000 % 60, elapsedMs % 1000);
+}
+
+void LeaderboardScreen::DrawBoard(ScoreBoard board, int x) {
+    DrawText(BOARD_TITLES[board], x, 110, 20, DARKGRAY);
+    DrawText(TextFormat("%i scores", counts[board]), x, 135, 14, GRAY);
+
+    const LatestScore& mine = latest[board];
+    int y = 165;
+    for (size_t i = 0; i < top[board].size(); i++, y += 30) {
+        const ScoreEntry& entry = top[board][i];
+        // Ties are told apart by time too, so the latest score is the row at its rank with its values
+        bool isLatest = (int)i + 1 == mine.rank && entry.score == mine.score && entry.elapsedMs == mine.elapsedMs;
+        Color color = isLatest ? GOLD : DARKGRAY;
+        DrawText(TextFormat("#%i", (int)i + 1), x, y, 18, color);
+        DrawText(TextFormat("%.12s", entry.name.c_str()), x + 45, y, 18, color);
+        DrawText(TextFormat("%i", entry.score), x + 190, y, 18, color);
+        DrawText(FormatTime(entry.elapsedMs), x + 260, y, 18, color);
+    }
+    if (top[board].empty()) DrawText("No scores yet", x, y, 18, LIGHTGRAY);
+
+    if (mine.rank > ROWS) {
+        DrawText(TextFormat("Your last game: #%i  (%i)", mine.rank, mine.score), x, 480, 18, GOLD);
+    }
+}
+
+void LeaderboardScreen::Draw() {
+    DrawText("LEADERBOARD", SCREEN_WIDTH/2 - MeasureText("LEADERBOARD", 40)/2, 40, 40, DARKGRAY);
+
+    boardScreen.Draw();
+
+    DrawBoard(BOARD_MEMORY, 40);
+    DrawBoard(BOARD_SUDOKU, 420);
+
+    DrawText("Scores on this computer", SCREEN_WIDTH/2 - MeasureText("Scores on this computer", 14)/2, 540, 14, LIGHTGRAY);
+}
@@ -0,0 +1,40 @@
+#ifndef LEADERBOARD_SCREEN_H
+#define LEADERBOARD_SCREEN_H
+
+#include "ScoreDatabase.h"
+
+// --- Local leaderboard screen (desktop) ---
+// The web page shows the online board next to the canvas; natively the same scores go to
+// ScoreDatabase, and this screen shows its top entries for both games side by side. The
+// player's latest score is highlighted, or listed under the top rows with its rank.
+
+class LeaderboardScreen {
+public:
+    static const int ROWS = 10; // Per board
+
+    static LeaderboardScreen& Get();
+
+    // SaveScoreToBrowser (js_interop.cpp), natively: the entry just inserted and its rank
+    void NoteScore(ScoreBoard board, int rank, int score, int elapsedMs);
+
+    void Open();
+    void Update();
+    void Draw();
+    bool IsActive() const { return active; }
+
+private:
+    struct LatestScore {
+        int rank; // 0 if none this session
+        int score;
+        int elapsedMs;
+    };
+
+    std::vector<ScoreEntry> top[BOARD_COUNT]; // Read on Open
+    int counts[BOARD_COUNT] = {};
+    LatestScore latest[BOARD_COUNT] = {};
+    bool active = false;
+
+    void DrawBoard(ScoreBoard board, int x);
+};
+
+#endif
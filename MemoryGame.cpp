@@ -1,5 +1,16 @@
 #include "MemoryGame.h"
 #include "js_interop.h"
+#include "PuzzleCode.h"
+#include "PlayerStats.h"
+#include "Telemetry.h"
+#include "InputLatency.h"
+#include "GameInput.h"
+#include "FixedTimestep.h"
+#include "VirtualScreen.h"
+#include "EffectQuality.h"
+#include "SpriteAtlas.h"
+#include "AudioFeedback.h"
+#include "UiScreen.h"
 
 #include <algorithm>
 #include <random>
@@ -7,11 +18,13 @@
 #include <cstdio>
 
 // Constants
-const int SCREEN_WIDTH = 800; // Needed for centering
-const int SCREEN_HEIGHT = 600;
 const int CARD_SIZE = 90; 
 const int CARD_SPACING = 15;
 const float FLIP_SPEED = 6.0f;
+const float REVEAL_DELAY = 0.8f; // Seconds both cards of a pair stay visible
+const int REVEAL_STEPS = (int)(REVEAL_DELAY * FixedTimestep::STEPS_PER_SECOND);
+const char* MEMORY_SNAPSHOT_FILE = "memory.sav";
+const uint16_t MEMORY_SNAPSHOT_VERSION = 2;
 const Color CARD_COLORS[] = {
     RED, ORANGE, YELLOW, GREEN, SKYBLUE, BLUE, PURPLE, PINK,
     LIME, GOLD, MAROON, DARKBLUE
@@ -20,7 +33,7 @@ const Color CARD_COLORS[] = {
 // Forward declaration of JS/Main functions
 // In a larger project, these would be in a "PlatformServices.h" interface
 // In MemoryGame.cpp (Forward declaration)
-extern void SaveScoreToBrowser(int score, int sortOrder);
+extern int SaveScoreToBrowser(int score, int sortOrder, int elapsedMs);
 extern void RefreshLeaderboard();
 
 void MemoryGame::Init() {
@@ -30,17 +43,34 @@ void MemoryGame::Init() {
     requestExit = false; // NEW: Initialize the exit flag
 }
 
+void MemoryGame::Open(bool canResume) {
+    Init();
+    if (canResume) LoadSnapshot();
+}
+
 bool MemoryGame::IsActive() {
     // We are active if we have NOT requested an exit
     return !requestExit; 
 }
 
 void MemoryGame::ReturnToMenu() {
-    // Called by main.cpp when returning to APP_MAIN_MENU. Resets the state for next time.
+    // Called through Close() when main.cpp returns to APP_MAIN_MENU
+    SaveSnapshot(); // Keep an unfinished board so the next visit resumes it
     state = MEM_MENU;
     requestExit = false; // NEW: Reset the flag
 }
 
+const char* MemoryGame::DescribeState() const {
+    switch (state) {
+        case MEM_MENU: return "MEM_MENU";
+        case MEM_PLAYING: return "MEM_PLAYING";
+        case MEM_WAITING: return "MEM_WAITING";
+        case MEM_GAMEOVER: return "MEM_GAMEOVER";
+        case MEM_HELP: return "MEM_HELP";
+    }
+    return "?";
+}
+
 std::vector<KeyDefinition> MemoryGame::GetKeyPool() {
     std::vector<KeyDefinition> pool;
     for (int i = 0; i <= 9; i++) {
@@ -60,17 +90,44 @@ std::vector<KeyDefinition> MemoryGame::GetKeyPool() {
     return pool;
 }
 
+// std::shuffle's algorithm differs between standard libraries; boards shared by seed
+// must come out identical on desktop and web, so shuffle explicitly.
+template <typename T>
+static void SeededShuffle(std::vector<T>& items, std::mt19937& g) {
+    for (size_t i = items.size(); i > 1; i--) {
+        size_t j = g() % i;
+        std::swap(items[i - 1], items[j]);
+    }
+}
+
 void MemoryGame::StartGame(MemoryDifficulty diff) {
+    std::random_device rd;
+    StartGame(diff, rd());
+}
+
+bool MemoryGame::StartFromCode(const std::string& code) {
+    int diff = 0;
+    uint32_t seed = 0;
+    if (!DecodeMemoryCode(code, diff, seed) || diff > DIFF_HARD) return false;
+    requestExit = false;
+    StartGame((MemoryDifficulty)diff, seed);
+    return true;
+}
+
+void MemoryGame::StartGame(MemoryDifficulty diff, uint32_t seed) {
     cards.clear();
     matchesFound = 0;
     moves = 0;
     errors = 0;
     finalScore = 0;
-    gameTime = 0;
-    timeAccumulator = 0.0;
+    leaderboardRank = 0;
+    finishMs = 0.0;
+    matchInputTime = -1.0;
     firstSelection = nullptr;
     secondSelection = nullptr;
     currentDifficulty = diff;
+    boardSeed = seed;
+    shareCode = EncodeMemoryCode(diff, seed);
     
     int rows = (diff == DIFF_MEDIUM) ? 4 : 5;
     int cols = (diff == DIFF_MEDIUM) ? 4 : 5;
@@ -84,10 +141,9 @@ void MemoryGame::StartGame(MemoryDifficulty diff) {
     }
 
     std::vector<KeyDefinition> keyPool = GetKeyPool();
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(ids.begin(), ids.end(), g);
-    std::shuffle(keyPool.begin(), keyPool.end(), g);
+    std::mt19937 g(seed);
+    SeededShuffle(ids, g);
+    SeededShuffle(keyPool, g);
 
     int gridWidth = (cols * CARD_SIZE) + ((cols - 1) * CARD_SPACING);
     int gridHeight = (rows * CARD_SIZE) + ((rows - 1) * CARD_SPACING);
@@ -109,6 +165,9 @@ void MemoryGame::StartGame(MemoryDifficulty diff) {
             c.flipped = false;
             c.matched = false;
             c.flipProgress = 0.0f; 
+            c.prevFlipProgress = 0.0f;
+            c.flipInputTime = -1.0;
+            c.faceInputTime = -1.0;
             
             bool isCenter = (diff == DIFF_HARD && x == 2 && y == 2);
             if (isCenter) {
@@ -129,56 +188,28 @@ void MemoryGame::StartGame(MemoryDifficulty diff) {
         }
     }
     state = MEM_PLAYING; 
+    clock.Reset();
+    Telemetry::Get().Record(TELE_MEMORY_START, diff, (int)cards.size());
     
-    // Call the external JS function
-    #if defined(PLATFORM_WEB)
-        RefreshLeaderboard();
-    #endif
+    // Web: re-fetches the online board. Desktop: prints the local score database.
+    RefreshLeaderboard();
 }
 
 void MemoryGame::Update() {
-    Vector2 mousePos = GetMousePosition();
-    bool mouseClicked = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-    float dt = GetFrameTime();
-
-    // Timer Logic
-    if (state == MEM_PLAYING || state == MEM_WAITING) {
-        timeAccumulator += dt;
-        if (timeAccumulator >= 1.0) {
-            gameTime++;
-            timeAccumulator -= 1.0;
-        }
-    }
-
-    // Animation Logic
-    for (auto& card : cards) {
-        if (!card.active) continue;
-        float target = card.flipped ? 1.0f : 0.0f;
-        if (card.flipProgress < target) {
-            card.flipProgress += dt * FLIP_SPEED;
-            if (card.flipProgress > target) card.flipProgress = target;
-        } else if (card.flipProgress > target) {
-            card.flipProgress -= dt * FLIP_SPEED;
-            if (card.flipProgress < target) card.flipProgress = target;
-        }
-    }
+    bool mouseClicked = InputClicked();
+    // Both screens are hit-tested every frame, so whichever one Draw shows is current
+    if (!menuScreen.IsBuilt()) BuildScreens();
+    menuScreen.Update();
+    playScreen.Update();
 
     // This is where you would move the back/exit button logic.
     // Setting requestExit = true replaces the direct appState change.
     if (state == MEM_GAMEOVER) {
-        if (IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+        if (InputKeyPressed(KEY_ENTER) || InputClicked()) {
             requestExit = true;
             return;
         }
     }
-    
-    // **Example: Back button logic for when in MEM_PLAYING**
-    // Assumes coordinates match the Draw function
-    Rectangle btnBack = { 20, 20, 100, 30 }; 
-    if (mouseClicked && CheckCollisionPointRec(mousePos, btnBack)) {
-        requestExit = true; // Exit from playing
-        return;
-    }
 
     switch (state) {
         case MEM_MENU:
@@ -186,73 +217,110 @@ void MemoryGame::Update() {
             break;
             
         case MEM_HELP:
-            if (mouseClicked || IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_ESCAPE)) state = MEM_MENU;
+            if (mouseClicked || InputKeyPressed(KEY_ENTER) || InputKeyPressed(KEY_ESCAPE)) state = MEM_MENU;
             break;
             
         case MEM_PLAYING: {
-            Rectangle btnMenu = { (float)SCREEN_WIDTH - 120, 20, 100, 30 };
-            if (mouseClicked && CheckCollisionPointRec(mousePos, btnMenu)) {
+            if (playScreen.Clicked(btnMenu)) {
+                ClearSnapshot(); // Abandoning the board for the difficulty menu
+                Telemetry::Get().Record(TELE_MEMORY_QUIT, 0, matchesFound);
                 state = MEM_MENU;
                 return;
             }
             
-            Card* cardToSelect = nullptr;
-            bool isKeySelection = false; 
-
-            // Mouse Interaction
-            if (mouseClicked) {
+            // Pointer: every press this frame, so two fingers can turn a pair together
+            bool pointerSelected = false;
+            for (int p = 0; p < InputPressCount() && state == MEM_PLAYING; p++) {
+                if (playScreen.PressTarget(p) >= 0) continue;
                 for (auto& card : cards) {
-                    if (card.active && CheckCollisionPointRec(mousePos, card.rect)) {
-                        cardToSelect = &card;
+                    if (card.active && CheckCollisionPointRec(InputPress(p), card.rect)) {
+                        pointerSelected |= SelectCard(card, false);
                         break;
                     }
                 }
             }
+            // Share: copy this board's code (Ctrl held, so it must not flip the 'C' card)
+            bool ctrlDown = InputKeyDown(KEY_LEFT_CONTROL) || InputKeyDown(KEY_RIGHT_CONTROL);
+            if (ctrlDown && InputKeyPressed(KEY_C)) {
+                CopyToClipboard(shareCode.c_str());
+                printf("Board code: %s\n", shareCode.c_str());
+            }
+
             // Keyboard Interaction
-            if (cardToSelect == nullptr) {
+            if (!pointerSelected && !ctrlDown && state == MEM_PLAYING) {
                 for (auto& card : cards) {
                     if (card.active && !card.matched && !card.flipped) {
-                         if (IsKeyPressed(card.assignedKey)) {
-                             cardToSelect = &card;
-                             isKeySelection = true;
+                         if (InputKeyPressed(card.assignedKey)) {
+                             SelectCard(card, true);
                              break; 
                          }
                     }
                 }
             }
-            
-            // Logic if card selected
-            if (cardToSelect) {
-                if (!cardToSelect->matched && !cardToSelect->flipped && cardToSelect->flipProgress < 0.5f) {
-                    cardToSelect->flipped = true;
-                    cardSeen[cardToSelect->gridIndex] = true;
-                    if (isKeySelection) cardToSelect->flipProgress = 1.0f;
-                    
-                    if (!firstSelection) {
-                        firstSelection = cardToSelect;
-                    } else {
-                        secondSelection = cardToSelect;
-                        moves++;
-                        state = MEM_WAITING;
-                        waitTimer = GetTime();
-                    }
-                }
-            }
             break;
         }
         case MEM_WAITING:
-            if (GetTime() - waitTimer > 0.8) { 
-                CheckMatch();
-            }
-            break;
+            break; // Resolved by Step once the reveal delay has run
             
         case MEM_GAMEOVER:
-            if (mouseClicked || IsKeyPressed(KEY_ENTER)) Init();
+            if (mouseClicked || InputKeyPressed(KEY_ENTER)) Init();
             break;
     }
 }
 
+// --- Fixed-step simulation ---
+// Runs FixedTimestep::STEPS_PER_SECOND times per second of real time, independent of the
+// display rate, so animations and the reveal delay take the same time everywhere
+void MemoryGame::Step(float dt) {
+    for (auto& card : cards) {
+        if (!card.active) continue;
+        card.prevFlipProgress = card.flipProgress;
+        float target = card.flipped ? 1.0f : 0.0f;
+        if (card.flipProgress < target) {
+            card.flipProgress += dt * FLIP_SPEED;
+            if (card.flipProgress > target) card.flipProgress = target;
+        } else if (card.flipProgress > target) {
+            card.flipProgress -= dt * FLIP_SPEED;
+            if (card.flipProgress < target) card.flipProgress = target;
+        }
+    }
+
+    if (state == MEM_WAITING && --revealStepsLeft <= 0) CheckMatch();
+}
+
+// Turns a card face up if it can be; false if it is matched, already up or still turning back
+bool MemoryGame::SelectCard(Card& card, bool isKeySelection) {
+    if (card.matched || card.flipped || card.flipProgress >= 0.5f) return false;
+    card.flipped = true;
+    cardSeen[card.gridIndex] = true;
+    Telemetry::Get().Record(TELE_CARD_FLIP, 0, card.gridIndex);
+    AudioFeedback::Get().Play(SOUND_FLIP);
+    if (isKeySelection) card.flipProgress = card.prevFlipProgress = 1.0f;
+
+    // Key flips show the face right away; clicks animate from the next frame
+    double inputTime = InputLatency::Get().InputTime();
+    if (isKeySelection) {
+        InputLatency::Get().Respond(LAT_CARD_FLIP, inputTime);
+        InputLatency::Get().Respond(LAT_CARD_FACE, inputTime);
+    } else {
+        card.flipInputTime = inputTime;
+        card.faceInputTime = inputTime;
+    }
+    
+    if (!firstSelection) {
+        firstSelection = &card;
+    } else {
+        secondSelection = &card;
+        moves++;
+        matchInputTime = inputTime;
+        state = MEM_WAITING;
+        revealStepsLeft = REVEAL_STEPS;
+    }
+    return true;
+}
+
 void MemoryGame::CheckMatch() {
+    InputLatency::Get().Respond(LAT_MATCH_RESULT, matchInputTime);
     if (!firstSelection || !secondSelection) {
         firstSelection = nullptr;
         secondSelection = nullptr;
@@ -263,12 +331,22 @@ void MemoryGame::CheckMatch() {
         firstSelection->matched = true;
         secondSelection->matched = true;
         matchesFound++;
+        Telemetry::Get().Record(TELE_CARD_MATCH, 0, firstSelection->gridIndex);
+        // Sounds with the frame that shows the result, not with the second card's input
+        AudioFeedback::Get().Play(matchesFound >= totalPairs ? SOUND_COMPLETE : SOUND_MATCH);
         
         if (matchesFound >= totalPairs) {
             state = MEM_GAMEOVER;
+            // The game ended with the second card's input, not after the reveal delay
+            finishMs = clock.ElapsedAt(matchInputTime);
+            clock.Stop();
+            int gameTime = (int)(finishMs / 1000.0);
             float multiplier = (currentDifficulty == DIFF_MEDIUM) ? 2.0f : 1.0f;
             finalScore = (int)((float)(moves + errors + gameTime) * multiplier);
-            SaveScoreToBrowser(finalScore, 0); // 0 = Low is Good (Golf scoring)
+            leaderboardRank = SaveScoreToBrowser(finalScore, 0, (int)finishMs); // 0 = Low is Good (Golf scoring)
+            Telemetry::Get().Record(TELE_MEMORY_WIN, 0, finalScore);
+            PlayerStats::Get().RecordMemoryGame(currentDifficulty, moves, errors, gameTime, finalScore);
+            ClearSnapshot();
         } else {
             state = MEM_PLAYING;
         }
@@ -279,99 +357,113 @@ void MemoryGame::CheckMatch() {
                 if (cardSeen[c.gridIndex] && c.gridIndex != secondSelection->gridIndex) errorDetected = true;
             }
         }
-        if (errorDetected) errors++;
+        AudioFeedback::Get().Play(SOUND_ERROR, errorDetected ? 1.0f : 0.5f);
+        if (errorDetected) {
+            errors++;
+            Telemetry::Get().Record(TELE_MEMORY_ERROR, 0, secondSelection->gridIndex);
+        }
         firstSelection->flipped = false;
         secondSelection->flipped = false;
         state = MEM_PLAYING;
     }
     firstSelection = nullptr;
     secondSelection = nullptr;
+    matchInputTime = -1.0;
+}
+
+// Declared once, on the first frame; both screens keep their buttons for the game's lifetime
+void MemoryGame::BuildScreens() {
+    const UiStyle mediumStyle = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKGRAY, 2, 24 };
+    const UiStyle hardStyle = { LIGHTGRAY, PINK, DARKGRAY, DARKGRAY, 2, 24 };
+    const UiStyle helpStyle = { LIGHTGRAY, GOLD, DARKGRAY, DARKGRAY, 2, 24 };
+    const UiStyle menuStyle = { DARKGRAY, MAROON, WHITE, RAYWHITE, 2, 12 };
+
+    btnMedium = menuScreen.AddButton({ (float)SCREEN_WIDTH/2 - 100, 250, 200, 50 }, "Medium (4x4)", mediumStyle);
+    btnHard = menuScreen.AddButton({ (float)SCREEN_WIDTH/2 - 100, 320, 200, 50 }, "Hard (5x5)", hardStyle);
+    btnHelp = menuScreen.AddButton({ (float)SCREEN_WIDTH/2 - 100, 390, 200, 50 }, "HOW TO PLAY", helpStyle);
+    btnBack = menuScreen.AddButton({ 20, 20, 100, 30 }, "BACK", UI_BACK_BUTTON);
+    menuScreen.SetIcon(btnHelp, SPRITE_ICON_HELP);
+    menuScreen.SetIcon(btnBack, SPRITE_ICON_BACK);
+
+    btnMenu = playScreen.AddButton({ (float)SCREEN_WIDTH - 120, 20, 70, 30 }, "MENU", menuStyle);
+    playScreen.SetIcon(btnMenu, SPRITE_ICON_MENU);
 }
 
 void MemoryGame::HandleMenuInput() {
-    Vector2 mousePos = GetMousePosition();
-    bool mouseClicked = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-
-    Rectangle btnMedium = { (float)SCREEN_WIDTH/2 - 100, 250, 200, 50 };
-    Rectangle btnHard = { (float)SCREEN_WIDTH/2 - 100, 320, 200, 50 };
-    Rectangle btnHelp = { (float)SCREEN_WIDTH/2 - 100, 390, 200, 50 };
-    // We treat the back button as a signal to the main loop to switch states
-    // But since this class doesn't know about AppState, we just expose an "Active" state or
-    // handle the drawing here. The Main loop handles the actual exit.
-    
-    // NOTE: The "Back" button logic is handled in Draw for the UI, 
-    // but the state change relies on the Main loop checking this class or us setting a flag.
-    // For this refactor, we will rely on Draw returning a signal or Main checking a button overlap.
-    // However, to keep it contained:
-    
-    if (mouseClicked) {
-        if (CheckCollisionPointRec(mousePos, btnMedium)) StartGame(DIFF_MEDIUM);
-        else if (CheckCollisionPointRec(mousePos, btnHard)) StartGame(DIFF_HARD);
-        else if (CheckCollisionPointRec(mousePos, btnHelp)) state = MEM_HELP;
+    if (menuScreen.Clicked(btnBack)) requestExit = true; // main.cpp returns to the arcade menu
+    else if (menuScreen.Clicked(btnMedium)) StartGame(DIFF_MEDIUM);
+    else if (menuScreen.Clicked(btnHard)) StartGame(DIFF_HARD);
+    else if (menuScreen.Clicked(btnHelp)) state = MEM_HELP;
+}
+
+// A card partway through its flip: squashed horizontally about its center
+struct CardPose {
+    Rectangle rect;
+    float scaleX;
+    bool showFront;
+};
+
+static CardPose PoseCard(const Card& card, float flipProgress) {
+    // A slow device turns cards in one step: the same face changes, without the squash frames
+    if (!EffectQuality::Get().SmoothFlips()) flipProgress = (flipProgress >= 0.5f) ? 1.0f : 0.0f;
+    CardPose pose;
+    pose.showFront = (flipProgress >= 0.5f);
+    pose.scaleX = fabsf(1.0f - (2.0f * flipProgress));
+    pose.rect = card.rect;
+    pose.rect.width = card.rect.width * pose.scaleX;
+    pose.rect.x = card.rect.x + (card.rect.width - pose.rect.width) / 2.0f;
+    return pose;
+}
+
+// Same face for the same pair, like CARD_COLORS
+static AtlasSprite CardFace(const Card& card) {
+    return (AtlasSprite)(SPRITE_CARD_FACE_00 + (card.id < 0 ? 0 : card.id) % SPRITE_CARD_FACE_COUNT);
+}
+
+// First pass: the card's picture. With the atlas loaded every card is a sprite from one
+// texture, so the whole board is one batch; the outlines and labels follow in DrawCardDetails.
+void MemoryGame::DrawCardArt(const Card& card, float flipProgress) {
+    if (!card.active) return;
+    CardPose pose = PoseCard(card, flipProgress);
+    const SpriteAtlas& atlas = SpriteAtlas::Get();
+    if (pose.showFront) {
+        if (!atlas.Draw(CardFace(card), pose.rect, card.matched ? Fade(WHITE, 0.3f) : WHITE)) {
+            DrawRectangleRec(pose.rect, card.matched ? Fade(card.color, 0.3f) : card.color);
+        }
+    } else if (!atlas.Draw(SPRITE_CARD_BACK, pose.rect, WHITE)) {
+        DrawRectangleRec(pose.rect, DARKGRAY);
     }
 }
 
-void MemoryGame::DrawCard(const Card& card) {
+void MemoryGame::DrawCardDetails(const Card& card, float flipProgress) {
     if (!card.active) return;
-    float animVal = card.flipProgress;
-    bool showFront = (animVal >= 0.5f);
-    float scaleX = fabsf(1.0f - (2.0f * animVal));
-    Rectangle r = card.rect;
-    float originalWidth = r.width;
-    r.width = originalWidth * scaleX;
-    r.x = card.rect.x + (originalWidth - r.width) / 2.0f;
-
-    if (showFront) {
+    CardPose pose = PoseCard(card, flipProgress);
+    Rectangle r = pose.rect;
+    if (pose.showFront) {
         if (card.matched) {
-            DrawRectangleRec(r, Fade(card.color, 0.3f));
             DrawRectangleLinesEx(r, 2, Fade(card.color, 0.5f));
         } else {
-            DrawRectangleRec(r, card.color);
             DrawRectangleLinesEx(r, 3, WHITE);
-            DrawCircle(r.x + r.width/2, r.y + r.height/2, 10 * scaleX, WHITE);
+            // The flat face's mark; artwork is its own
+            if (!SpriteAtlas::Get().Has(CardFace(card))) {
+                DrawCircle(r.x + r.width/2, r.y + r.height/2, 10 * pose.scaleX, WHITE);
+            }
         }
     } else {
-        DrawRectangleRec(r, DARKGRAY);
         DrawRectangleLinesEx(r, 3, GRAY);
-        if (scaleX > 0.4f && !card.matched) {
+        if (pose.scaleX > 0.4f && !card.matched) {
             int fontSize = 40;
             int textWidth = MeasureText(card.keyLabel, fontSize);
-            DrawText(card.keyLabel, (int)(r.x + (r.width - textWidth * scaleX)/2), (int)(r.y + (r.height - fontSize)/2), fontSize, LIGHTGRAY);
+            DrawText(card.keyLabel, (int)(r.x + (r.width - textWidth * pose.scaleX)/2), (int)(r.y + (r.height - fontSize)/2), fontSize, LIGHTGRAY);
         }
     }
 }
 
-void MemoryGame::Draw() {
-    Vector2 mousePos = GetMousePosition();
-
+void MemoryGame::Draw(float alpha) {
     if (state == MEM_MENU) {
         DrawText("MEMORY GAME", SCREEN_WIDTH/2 - MeasureText("MEMORY GAME", 60)/2, 130, 60, DARKGRAY);
         
-        Rectangle btnMedium = { (float)SCREEN_WIDTH/2 - 100, 250, 200, 50 };
-        Rectangle btnHard = { (float)SCREEN_WIDTH/2 - 100, 320, 200, 50 };
-        Rectangle btnHelp = { (float)SCREEN_WIDTH/2 - 100, 390, 200, 50 };
-        Rectangle btnBack = { 20, 20, 100, 30 };
-        
-        Color medColor = CheckCollisionPointRec(mousePos, btnMedium) ? SKYBLUE : LIGHTGRAY;
-        Color hardColor = CheckCollisionPointRec(mousePos, btnHard) ? PINK : LIGHTGRAY;
-        Color helpColor = CheckCollisionPointRec(mousePos, btnHelp) ? GOLD : LIGHTGRAY;
-
-        DrawRectangleRec(btnMedium, medColor); DrawRectangleLinesEx(btnMedium, 2, DARKGRAY);
-        DrawText("Medium (4x4)", (int)btnMedium.x + 20, (int)btnMedium.y + 10, 24, DARKGRAY);
-
-        DrawRectangleRec(btnHard, hardColor); DrawRectangleLinesEx(btnHard, 2, DARKGRAY);
-        DrawText("Hard (5x5)", (int)btnHard.x + 35, (int)btnHard.y + 10, 24, DARKGRAY);
-
-        DrawRectangleRec(btnHelp, helpColor); DrawRectangleLinesEx(btnHelp, 2, DARKGRAY);
-        DrawText("HOW TO PLAY", (int)btnHelp.x + 20, (int)btnHelp.y + 10, 24, DARKGRAY);
-
-        // Draw Back Button
-        DrawRectangleRec(btnBack, LIGHTGRAY); DrawRectangleLinesEx(btnBack, 1, DARKGRAY);
-        DrawText("BACK", 45, 28, 10, DARKGRAY);
-        
-        // Note: The click handling for BACK is done in Main.cpp to switch AppState, 
-        // OR we can handle it here and expose a "ExitRequested" flag. 
-        // For simplicity in this architecture, Main.cpp checks this specific button.
+        menuScreen.Draw();
     } 
     else if (state == MEM_HELP) {
         DrawText("HOW TO PLAY", SCREEN_WIDTH/2 - MeasureText("HOW TO PLAY", 40)/2, 60, 40, SKYBLUE);
@@ -390,23 +482,164 @@ void MemoryGame::Draw() {
     }
     else if (state == MEM_GAMEOVER) {
         DrawText("YOU WIN!", SCREEN_WIDTH/2 - MeasureText("YOU WIN!", 60)/2, 130, 60, GOLD);
-        const char* statsText = TextFormat("Moves: %i   Errors: %i   Time: %is", moves, errors, gameTime);
+        const char* statsText = TextFormat("Moves: %i   Errors: %i   Time: %.3fs", moves, errors, finishMs / 1000.0);
         DrawText(statsText, SCREEN_WIDTH/2 - MeasureText(statsText, 24)/2, 220, 24, DARKGRAY);
         const char* scoreText = TextFormat("FINAL SCORE: %i", finalScore);
         DrawText(scoreText, SCREEN_WIDTH/2 - MeasureText(scoreText, 40)/2, 270, 40, SKYBLUE);
+        if (leaderboardRank > 0) {
+            const char* rankText = TextFormat("Leaderboard rank: #%i", leaderboardRank);
+            DrawText(rankText, SCREEN_WIDTH/2 - MeasureText(rankText, 24)/2, 330, 24, GOLD);
+        }
         DrawText("Click or Press Enter to Return to Menu", SCREEN_WIDTH/2 - MeasureText("Click or Press Enter to Return to Menu", 20)/2, 450, 20, LIGHTGRAY);
     }
     else {
         // Playing
-        for (const auto& card : cards) DrawCard(card);
+        for (const auto& card : cards) {
+            DrawCardArt(card, card.prevFlipProgress + (card.flipProgress - card.prevFlipProgress) * alpha);
+        }
+        for (auto& card : cards) {
+            float shown = card.prevFlipProgress + (card.flipProgress - card.prevFlipProgress) * alpha;
+            DrawCardDetails(card, shown);
+
+            // Latency: this frame is the first to show the card turning / its face
+            if (card.flipInputTime >= 0 && shown > 0.0f) {
+                InputLatency::Get().Respond(LAT_CARD_FLIP, card.flipInputTime);
+                card.flipInputTime = -1.0;
+            }
+            if (card.faceInputTime >= 0 && shown >= 0.5f) {
+                InputLatency::Get().Respond(LAT_CARD_FACE, card.faceInputTime);
+                card.faceInputTime = -1.0;
+            }
+        }
         DrawText(TextFormat("Moves: %i", moves), 20, 20, 20, DARKGRAY);
         DrawText(TextFormat("Errors: %i", errors), 20, 45, 20, MAROON);
-        DrawText(TextFormat("Time: %i", gameTime), 20, 70, 20, DARKGREEN);
+        DrawText(TextFormat("Time: %i", clock.Seconds()), 20, 70, 20, DARKGREEN);
+        DrawText(TextFormat("Code: %s  (Ctrl+C to copy)", shareCode.c_str()), 20, SCREEN_HEIGHT - 20, 10, GRAY);
         
-        Rectangle btnMenu = { (float)SCREEN_WIDTH - 120, 20, 70, 30 };
-        Color btnColor = CheckCollisionPointRec(mousePos, btnMenu) ? MAROON : DARKGRAY;
-        DrawRectangleRec(btnMenu, btnColor);
-        DrawRectangleLinesEx(btnMenu, 2, WHITE);
-        DrawText("MENU", (int)btnMenu.x + 8, (int)btnMenu.y + 8, 12, RAYWHITE);
+        playScreen.Draw();
     }
+}
+
+// --- Save/Resume ---
+// Payload v1: difficulty, stats, selections (as card indices), then per card
+// (rect, id, key, label, flags) and the cardSeen bits. v2 appends the board seed.
+void MemoryGame::SaveSnapshot() {
+    if (!HasGameInProgress()) return;
+
+    ByteWriter& out = snapshotBuffer;
+    out.Clear();
+    out.U8((uint8_t)currentDifficulty);
+    out.I32(matchesFound);
+    out.I32(moves);
+    out.I32(errors);
+    out.I32(totalPairs);
+    double elapsedMs = clock.ElapsedMs(); // Stored as whole seconds + fraction, as in v1
+    out.I32((int)(elapsedMs / 1000.0));
+    out.F64(fmod(elapsedMs, 1000.0) / 1000.0);
+    out.I32(firstSelection ? (int)(firstSelection - cards.data()) : -1);
+    out.I32(secondSelection ? (int)(secondSelection - cards.data()) : -1);
+
+    out.U8((uint8_t)cards.size());
+    for (const auto& c : cards) {
+        out.Bytes(&c.rect, sizeof(c.rect));
+        out.I32(c.id);
+        out.I32(c.gridIndex);
+        out.U16((uint16_t)c.assignedKey);
+        out.U8((uint8_t)c.keyLabel[0]);
+        out.U8((c.flipped ? 1 : 0) | (c.matched ? 2 : 0) | (c.active ? 4 : 0));
+    }
+    for (size_t i = 0; i < cardSeen.size(); i++) out.U8(cardSeen[i] ? 1 : 0);
+    out.U32(boardSeed);
+
+    WriteSnapshotFile(MEMORY_SNAPSHOT_FILE, SNAP_MEMORY, MEMORY_SNAPSHOT_VERSION, out);
+}
+
+bool MemoryGame::LoadSnapshot() {
+    uint16_t version = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadSnapshotFile(MEMORY_SNAPSHOT_FILE, SNAP_MEMORY, version, payload)) return false;
+    if (version < 1 || version > MEMORY_SNAPSHOT_VERSION) return false;
+
+    ByteReader in(payload.data(), payload.size());
+    int diff = in.U8();
+    int loadedMatches = in.I32();
+    int loadedMoves = in.I32();
+    int loadedErrors = in.I32();
+    int loadedPairs = in.I32();
+    int loadedTime = in.I32();
+    double loadedAccumulator = in.F64();
+    int firstIdx = in.I32();
+    int secondIdx = in.I32();
+    if (diff != DIFF_MEDIUM && diff != DIFF_HARD) return false;
+
+    std::vector<Card> loadedCards(in.U8());
+    for (auto& c : loadedCards) {
+        in.Bytes(&c.rect, sizeof(c.rect));
+        c.id = in.I32();
+        c.gridIndex = in.I32();
+        c.assignedKey = (KeyboardKey)in.U16();
+        c.keyLabel[0] = (char)in.U8();
+        c.keyLabel[1] = '\0';
+        uint8_t flags = in.U8();
+        c.flipped = (flags & 1) != 0;
+        c.matched = (flags & 2) != 0;
+        c.active = (flags & 4) != 0;
+        c.color = c.active ? CARD_COLORS[(c.id < 0 ? 0 : c.id) % 12] : DARKGRAY;
+        c.flipProgress = (c.flipped || c.matched) ? 1.0f : 0.0f;
+        c.prevFlipProgress = c.flipProgress;
+        c.flipInputTime = -1.0;
+        c.faceInputTime = -1.0;
+        if (c.gridIndex < 0 || c.gridIndex >= (int)loadedCards.size()) return false;
+    }
+    std::vector<bool> loadedSeen(loadedCards.size());
+    for (size_t i = 0; i < loadedSeen.size(); i++) loadedSeen[i] = in.U8() != 0;
+    uint32_t loadedSeed = (version >= 2) ? in.U32() : 0;
+
+    int cardCount = (int)loadedCards.size();
+    if (!in.Ok() || !in.AtEnd() || cardCount == 0) return false;
+    if (firstIdx < -1 || firstIdx >= cardCount || secondIdx < -1 || secondIdx >= cardCount) return false;
+
+    // Everything validated, commit
+    cards.swap(loadedCards);
+    cardSeen.swap(loadedSeen);
+    currentDifficulty = (MemoryDifficulty)diff;
+    boardSeed = loadedSeed;
+    shareCode = (version >= 2) ? EncodeMemoryCode(diff, loadedSeed) : ""; // v1 did not keep the seed
+    matchesFound = loadedMatches;
+    moves = loadedMoves;
+    errors = loadedErrors;
+    totalPairs = loadedPairs;
+    clock.Reset(loadedTime * 1000.0 + loadedAccumulator * 1000.0);
+    finishMs = 0.0;
+    matchInputTime = -1.0;
+    finalScore = 0;
+    leaderboardRank = 0;
+    requestExit = false;
+    firstSelection = (firstIdx >= 0) ? &cards[firstIdx] : nullptr;
+    secondSelection = (secondIdx >= 0) ? &cards[secondIdx] : nullptr;
+
+    // A pending pair resumes in the reveal delay so the player sees both cards again
+    if (firstSelection && secondSelection) {
+        state = MEM_WAITING;
+        revealStepsLeft = REVEAL_STEPS;
+    } else {
+        state = MEM_PLAYING;
+    }
+    return true;
+}
+
+void MemoryGame::ClearSnapshot() {
+    DeleteSnapshotFile(MEMORY_SNAPSHOT_FILE);
+}
+
+// --- Module entry (GameModule.h) ---
+static GameModule* CreateMemoryGame() {
+    MemoryGame* game = new MemoryGame();
+    game->Init();
+    return game;
+}
+
+GAME_MODULE_EXPORT const GameModuleEntry* MemoryGameEntry() {
+    static const GameModuleEntry entry = { CreateMemoryGame, nullptr };
+    return &entry;
 }
\ No newline at end of file
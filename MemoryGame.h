@@ -2,8 +2,13 @@
 #define MEMORY_GAME_H
 
 #include "raylib.h"
+#include "Snapshot.h"
+#include "GameClock.h"
+#include "GameModule.h"
+#include "UiScreen.h"
 #include <vector>
 #include <string>
+#include <cstdint>
 
 // --- Enums & Structs specific to Memory Game ---
 enum MemoryDifficulty {
@@ -30,6 +35,9 @@ struct Card {
     KeyboardKey assignedKey; 
     char keyLabel[2];
     float flipProgress; 
+    float prevFlipProgress; // Before the last simulation step, for interpolated drawing
+    double flipInputTime; // Latency: input waiting for the first turning frame (-1 if none)
+    double faceInputTime; // ...and for the first frame showing the face
 };
 
 struct KeyDefinition {
@@ -37,41 +45,74 @@ struct KeyDefinition {
     char label[2]; 
 };
 
-class MemoryGame {
+class MemoryGame : public GameModule {
 public:
     void Init();
+    void Open(bool canResume) override;
     void StartGame(MemoryDifficulty diff);
-    void Update();
-    void Draw();
-    bool IsActive();
+    void StartGame(MemoryDifficulty diff, uint32_t seed); // Same seed + difficulty = same board
+    bool StartFromCode(const std::string& code) override; // Plays a shared board, false if invalid
+    void Update() override;       // Input, once per frame
+    void Step(float dt) override; // Fixed-step simulation: flip animation, reveal delay
+    void Draw(float alpha) override;
+    bool IsActive() override;
+    void Close() override { ReturnToMenu(); }
     void ReturnToMenu();
 
+    // Save/Resume (autosaved by main.cpp while a board is in progress)
+    bool HasGameInProgress() const override { return state == MEM_PLAYING || state == MEM_WAITING; }
+    void SaveSnapshot() override;
+    bool LoadSnapshot(); // Restores the saved board straight into MEM_PLAYING
+    void ClearSnapshot();
+
+    // App hidden/minimized: the game clock stops counting
+    void SetPaused(bool paused) override { if (paused) clock.Pause(); else clock.Resume(); }
+
+    // Sharing
+    const std::string& GetShareCode() const { return shareCode; }
+
+    // Hitch reports: the MEM_* state
+    const char* DescribeState() const override;
+
 private:
     // Game State
     std::vector<Card> cards;
     MemoryGameState state;
     MemoryDifficulty currentDifficulty;
+    uint32_t boardSeed;
+    std::string shareCode;
     
     // Logic Pointers
     Card* firstSelection;
     Card* secondSelection;
     
     // Stats
-    double waitTimer;
+    int revealStepsLeft;   // MEM_WAITING: simulation steps until the pair is resolved
+    double matchInputTime; // Latency: second card's input, reported when the result shows
     int matchesFound;
     int moves;
     int errors;
     int totalPairs;
     int finalScore; 
+    int leaderboardRank;    // Local leaderboard, natively; 0 on the web (the page ranks it)
     bool requestExit; // NEW: Flag to signal main.cpp to change AppState
-    int gameTime;           
-    double timeAccumulator;
+    GameClock clock;        // Runs from StartGame, stopped on the winning pair
+    double finishMs;        // Time of the winning pair's second card (tiebreak on the leaderboard)
     std::vector<bool> cardSeen; 
+    ByteWriter snapshotBuffer; // Reused between autosaves
+
+    // Buttons: the difficulty menu's, and MENU while playing
+    UiScreen menuScreen;
+    UiScreen playScreen;
+    int btnMedium, btnHard, btnHelp, btnBack, btnMenu;
 
     // Internal Helpers
-    void DrawCard(const Card& card);
+    void DrawCardArt(const Card& card, float flipProgress);     // Drawn for every card first...
+    void DrawCardDetails(const Card& card, float flipProgress); // ...then outlines and key labels
     std::vector<KeyDefinition> GetKeyPool();
+    bool SelectCard(Card& card, bool isKeySelection); // Pointer or key on a card while playing
     void CheckMatch();
+    void BuildScreens();
     void HandleMenuInput();
 };
 
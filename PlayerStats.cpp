@@ -0,0 +1,271 @@
+#include "PlayerStats.h"
+#include "InteropMessages.h"
+#include "GameInput.h"
+#include "VirtualScreen.h"
+#include "UiScreen.h"
+#include <cstdio>
+#include <ctime>
+
+// Constants
+const char* HISTORY_LOG_FILE = "history.log";
+const char* STATS_FILE = "stats.bin";
+const uint16_t STATS_VERSION = 2; // v1 mixed the Memory difficulties; rebuilt from the history
+const uint8_t HISTORY_RECORD_VERSION = 1;
+const int TREND_GAMES = 10; // "Last 10" column
+const int MEMORY_METRICS = 4; // Score, moves, errors, time: per difficulty, from STAT_MEMORY_SCORE_MEDIUM
+const int ROW_SPACING = 38;   // Stats screen
+
+enum HistoryGame : uint8_t { HISTORY_MEMORY = 0, HISTORY_SUDOKU = 1 };
+
+struct MetricInfo {
+    const char* label;
+    bool isTime;
+};
+
+const MetricInfo METRICS[STAT_COUNT] = {
+    { "Memory score (medium)", false },
+    { "Memory moves (medium)", false },
+    { "Memory errors (medium)", false },
+    { "Memory time (medium)", true },
+    { "Memory score (hard)", false },
+    { "Memory moves (hard)", false },
+    { "Memory errors (hard)", false },
+    { "Memory time (hard)", true },
+    { "Sudoku time (medium)", true },
+    { "Sudoku time (hard)", true }
+};
+
+PlayerStats& PlayerStats::Get() {
+    static PlayerStats instance;
+    return instance;
+}
+
+void PlayerStats::Reset() {
+    for (int m = 0; m < STAT_COUNT; m++) {
+        sketches[m].Clear();
+        recentCount[m] = 0;
+        recentHead[m] = 0;
+    }
+}
+
+// Loaded on first use: on the web, save storage is only ready after startup
+void PlayerStats::EnsureLoaded() {
+    if (loaded) return;
+    loaded = true;
+    if (!Load()) RebuildFromHistory();
+    for (int m = 0; m < STAT_COUNT; m++) Summarize((StatMetric)m);
+}
+
+// --- Recording ---
+void PlayerStats::Add(StatMetric metric, float value) {
+    sketches[metric].Add(value);
+    recent[metric][recentHead[metric]] = value;
+    recentHead[metric] = (recentHead[metric] + 1) % RECENT_GAMES;
+    if (recentCount[metric] < RECENT_GAMES) recentCount[metric]++;
+}
+
+// History record: version, game, difficulty, unix time, moves, errors, seconds, score
+void PlayerStats::ApplyRecord(ByteReader& record) {
+    int version = record.U8();
+    int game = record.U8();
+    int difficulty = record.U8();
+    record.U32(); // Timestamp, only kept for the raw history
+    int moves = record.I32();
+    int errors = record.I32();
+    int seconds = record.I32();
+    int score = record.I32();
+    if (!record.Ok() || version != HISTORY_RECORD_VERSION) return;
+
+    if (game == HISTORY_MEMORY) {
+        int first = difficulty == 0 ? STAT_MEMORY_SCORE_MEDIUM : STAT_MEMORY_SCORE_HARD;
+        Add((StatMetric)(first + 0), (float)score);
+        Add((StatMetric)(first + 1), (float)moves);
+        Add((StatMetric)(first + 2), (float)errors);
+        Add((StatMetric)(first + 3), (float)seconds);
+    } else if (game == HISTORY_SUDOKU) {
+        Add(difficulty == 0 ? STAT_SUDOKU_TIME_MEDIUM : STAT_SUDOKU_TIME_HARD, (float)seconds);
+    }
+}
+
+static void WriteHistoryRecord(ByteWriter& out, HistoryGame game, int difficulty, int moves, int errors, int seconds, int score) {
+    out.Clear();
+    out.U8(HISTORY_RECORD_VERSION);
+    out.U8(game);
+    out.U8((uint8_t)difficulty);
+    out.U32((uint32_t)time(nullptr));
+    out.I32(moves);
+    out.I32(errors);
+    out.I32(seconds);
+    out.I32(score);
+}
+
+void PlayerStats::RecordMemoryGame(int difficulty, int moves, int errors, int seconds, int score) {
+    EnsureLoaded();
+    WriteHistoryRecord(saveBuffer, HISTORY_MEMORY, difficulty, moves, errors, seconds, score);
+    AppendLogRecord(HISTORY_LOG_FILE, saveBuffer);
+
+    ByteReader record(saveBuffer.Data().data(), saveBuffer.Data().size());
+    ApplyRecord(record);
+    int first = difficulty == 0 ? STAT_MEMORY_SCORE_MEDIUM : STAT_MEMORY_SCORE_HARD;
+    for (int m = first; m < first + MEMORY_METRICS; m++) Summarize((StatMetric)m);
+    Save();
+
+    MsgGameFinished message = { HISTORY_MEMORY, (uint8_t)difficulty, seconds, score, moves, errors };
+    SendInteropMessage(message);
+}
+
+void PlayerStats::RecordSudokuGame(int difficulty, int seconds, int score) {
+    EnsureLoaded();
+    WriteHistoryRecord(saveBuffer, HISTORY_SUDOKU, difficulty, 0, 0, seconds, score);
+    AppendLogRecord(HISTORY_LOG_FILE, saveBuffer);
+
+    ByteReader record(saveBuffer.Data().data(), saveBuffer.Data().size());
+    ApplyRecord(record);
+    Summarize(STAT_SUDOKU_TIME_MEDIUM);
+    Summarize(STAT_SUDOKU_TIME_HARD);
+    Save();
+
+    MsgGameFinished message = { HISTORY_SUDOKU, (uint8_t)difficulty, seconds, score, 0, 0 };
+    SendInteropMessage(message);
+}
+
+// Percentiles are computed here, once per finished game, never per frame
+void PlayerStats::Summarize(StatMetric metric) {
+    const KllSketch& sketch = sketches[metric];
+    MetricSummary& s = summary[metric];
+    s.games = sketch.Count();
+    s.best = sketch.Min();
+    s.p10 = sketch.Quantile(0.10);
+    s.p50 = sketch.Quantile(0.50);
+    s.p90 = sketch.Quantile(0.90);
+
+    int n = recentCount[metric] < TREND_GAMES ? recentCount[metric] : TREND_GAMES;
+    float total = 0.0f;
+    for (int k = 1; k <= n; k++) total += recent[metric][(recentHead[metric] - k + RECENT_GAMES) % RECENT_GAMES];
+    s.recentAverage = (n > 0) ? total / n : 0.0f;
+}
+
+// --- Persistence ---
+// Payload: per metric, the sketch, then recent count, head and RECENT_GAMES floats
+void PlayerStats::Save() {
+    ByteWriter& out = saveBuffer;
+    out.Clear();
+    for (int m = 0; m < STAT_COUNT; m++) {
+        sketches[m].Write(out);
+        out.U8((uint8_t)recentCount[m]);
+        out.U8((uint8_t)recentHead[m]);
+        for (int k = 0; k < RECENT_GAMES; k++) out.F32(recentCount[m] > k ? recent[m][k] : 0.0f);
+    }
+    WriteSnapshotFile(STATS_FILE, SNAP_STATS, STATS_VERSION, out);
+}
+
+bool PlayerStats::Load() {
+    Reset();
+    uint16_t version = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadSnapshotFile(STATS_FILE, SNAP_STATS, version, payload)) return false;
+    if (version != STATS_VERSION) return false;
+
+    ByteReader in(payload.data(), payload.size());
+    for (int m = 0; m < STAT_COUNT; m++) {
+        if (!sketches[m].Read(in)) { Reset(); return false; }
+        recentCount[m] = in.U8();
+        recentHead[m] = in.U8();
+        for (int k = 0; k < RECENT_GAMES; k++) recent[m][k] = in.F32();
+        if (recentCount[m] > RECENT_GAMES || recentHead[m] >= RECENT_GAMES) { Reset(); return false; }
+    }
+    if (!in.Ok() || !in.AtEnd()) { Reset(); return false; }
+    return true;
+}
+
+void PlayerStats::RebuildFromHistory() {
+    Reset();
+    if (!ReadLogRecords(HISTORY_LOG_FILE, [this](ByteReader& record) { ApplyRecord(record); })) return;
+    printf("Stats rebuilt from history (%llu games)\n",
+           (unsigned long long)(sketches[STAT_MEMORY_SCORE_MEDIUM].Count() + sketches[STAT_MEMORY_SCORE_HARD].Count() +
+                                sketches[STAT_SUDOKU_TIME_MEDIUM].Count() + sketches[STAT_SUDOKU_TIME_HARD].Count()));
+    Save();
+}
+
+// --- Stats screen ---
+static UiScreen statsScreen;
+static int btnBack;
+
+void PlayerStats::Open() {
+    EnsureLoaded();
+    active = true;
+}
+
+void PlayerStats::Update() {
+    if (!statsScreen.IsBuilt()) {
+        btnBack = statsScreen.AddButton({ 20, 20, 100, 30 }, "BACK", UI_BACK_BUTTON);
+        statsScreen.SetIcon(btnBack, SPRITE_ICON_BACK);
+    }
+    statsScreen.Update();
+    if (statsScreen.Clicked(btnBack) || InputKeyPressed(KEY_ENTER)) {
+        active = false;
+    }
+}
+
+static const char* FormatStat(float value, bool isTime) {
+    int v = (int)(value + 0.5f);
+    if (isTime) return TextFormat("%i:%02i", v / 60, v % 60);
+    return TextFormat("%i", v);
+}
+
+void PlayerStats::Draw() {
+    DrawText("PLAYER STATS", SCREEN_WIDTH/2 - MeasureText("PLAYER STATS", 40)/2, 40, 40, DARKGRAY);
+
+    statsScreen.Draw();
+
+    // Columns
+    const int colGames = 260, colBest = 325, colP10 = 390, colP50 = 455, colP90 = 520, colRecent = 590, colTrend = 680;
+    int y = 120;
+    DrawText("Games", colGames, y, 16, GRAY);
+    DrawText("Best", colBest, y, 16, GRAY);
+    DrawText("p10", colP10, y, 16, GRAY);
+    DrawText("Median", colP50, y, 16, GRAY);
+    DrawText("p90", colP90, y, 16, GRAY);
+    DrawText("Last 10", colRecent, y, 16, GRAY);
+    DrawText("Trend", colTrend, y, 16, GRAY);
+
+    for (int m = 0; m < STAT_COUNT; m++) {
+        y = 160 + m * ROW_SPACING;
+        const MetricSummary& s = summary[m];
+        bool isTime = METRICS[m].isTime;
+        DrawText(METRICS[m].label, 30, y, 16, DARKGRAY);
+        DrawText(TextFormat("%llu", (unsigned long long)s.games), colGames, y, 18, DARKGRAY);
+        if (s.games == 0) {
+            DrawText("-", colBest, y, 18, LIGHTGRAY);
+            continue;
+        }
+        DrawText(FormatStat(s.best, isTime), colBest, y, 18, GOLD);
+        DrawText(FormatStat(s.p10, isTime), colP10, y, 18, DARKGRAY);
+        DrawText(FormatStat(s.p50, isTime), colP50, y, 18, DARKGRAY);
+        DrawText(FormatStat(s.p90, isTime), colP90, y, 18, DARKGRAY);
+        // Lower is better everywhere: beating your own median is green
+        DrawText(FormatStat(s.recentAverage, isTime), colRecent, y, 18, s.recentAverage <= s.p50 ? DARKGREEN : MAROON);
+
+        // Sparkline of the last RECENT_GAMES values, oldest on the left
+        int n = recentCount[m];
+        if (n < 2) continue;
+        float lo = recent[m][0], hi = recent[m][0];
+        for (int k = 0; k < n; k++) {
+            lo = recent[m][k] < lo ? recent[m][k] : lo;
+            hi = recent[m][k] > hi ? recent[m][k] : hi;
+        }
+        float range = (hi > lo) ? hi - lo : 1.0f;
+        const float width = 100.0f, height = 24.0f;
+        int oldest = (recentHead[m] - n + RECENT_GAMES) % RECENT_GAMES;
+        Vector2 prev = { 0, 0 };
+        for (int k = 0; k < n; k++) {
+            float v = recent[m][(oldest + k) % RECENT_GAMES];
+            Vector2 point = { colTrend + width * k / (n - 1), y + height - height * (v - lo) / range };
+            if (k > 0) DrawLineV(prev, point, SKYBLUE);
+            prev = point;
+        }
+    }
+
+    DrawText("Percentiles are estimated from compact sketches of your full history",
+             SCREEN_WIDTH/2 - MeasureText("Percentiles are estimated from compact sketches of your full history", 14)/2, 540, 14, LIGHTGRAY);
+}
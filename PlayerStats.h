@@ -0,0 +1,73 @@
+#ifndef PLAYER_STATS_H
+#define PLAYER_STATS_H
+
+#include "raylib.h"
+#include "QuantileSketch.h"
+#include <cstdint>
+
+// --- Player history & stats dashboard ---
+// Every finished game is appended to "history.log" (raw records, never rescanned for
+// display) and folded into "stats.bin": one KLL sketch per metric plus the last few
+// values for trends. The dashboard only reads cached summaries, so it renders instantly
+// however long the history is. If stats.bin is lost, it is rebuilt from the log once.
+
+// All metrics are "lower is better". Each difficulty has its own: the boards differ in size and
+// medium scores are doubled, so mixing them would blur both.
+enum StatMetric {
+    STAT_MEMORY_SCORE_MEDIUM, // Memory metrics: score, moves, errors, time, per difficulty
+    STAT_MEMORY_MOVES_MEDIUM,
+    STAT_MEMORY_ERRORS_MEDIUM,
+    STAT_MEMORY_TIME_MEDIUM,
+    STAT_MEMORY_SCORE_HARD,
+    STAT_MEMORY_MOVES_HARD,
+    STAT_MEMORY_ERRORS_HARD,
+    STAT_MEMORY_TIME_HARD,
+    STAT_SUDOKU_TIME_MEDIUM,
+    STAT_SUDOKU_TIME_HARD,
+    STAT_COUNT
+};
+
+class PlayerStats {
+public:
+    static const int RECENT_GAMES = 20; // Per metric, for the trend line
+
+    static PlayerStats& Get();
+
+    // Called by the games when a game is won
+    void RecordMemoryGame(int difficulty, int moves, int errors, int seconds, int score);
+    void RecordSudokuGame(int difficulty, int seconds, int score);
+
+    // Stats screen
+    void Open();
+    void Update();
+    void Draw();
+    bool IsActive() const { return active; }
+
+private:
+    struct MetricSummary {
+        uint64_t games;
+        float best;
+        float p10, p50, p90;
+        float recentAverage; // Last 10 games
+    };
+
+    KllSketch sketches[STAT_COUNT];
+    float recent[STAT_COUNT][RECENT_GAMES]; // Ring buffer, oldest overwritten
+    int recentCount[STAT_COUNT];
+    int recentHead[STAT_COUNT];
+    MetricSummary summary[STAT_COUNT];
+    bool loaded = false;
+    bool active = false;
+    ByteWriter saveBuffer;
+
+    void EnsureLoaded();
+    bool Load();
+    void Save();
+    void RebuildFromHistory();
+    void Reset();
+    void Add(StatMetric metric, float value);
+    void Summarize(StatMetric metric);
+    void ApplyRecord(ByteReader& record);
+};
+
+#endif
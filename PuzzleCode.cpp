@@ -0,0 +1,454 @@
+#include "PuzzleCode.h"
+#include <vector>
+#include <cstring>
+
+// Constants
+const int CODE_VERSION = 0;
+const uint32_t RC_TOP = 1u << 24;
+const int PROB_BITS = 12;
+const uint32_t PROB_ONE = 1u << PROB_BITS;
+const int PROB_SHIFT = 4; // Adaptation speed of the bit models
+const size_t MAX_PADDING = 8; // Zero bytes a decode may read past the code: the stripped flush (3-4) plus slack
+const char BASE64URL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// --- Range coder (LZMA-style carry handling) ---
+class RangeEncoder {
+public:
+    RangeEncoder() : low(0), range(0xFFFFFFFFu), cache(0), cacheSize(1) {}
+
+    void Encode(uint32_t start, uint32_t size, uint32_t total) {
+        range /= total;
+        low += (uint64_t)start * range;
+        range *= size;
+        while (range < RC_TOP) { range <<= 8; ShiftLow(); }
+    }
+
+    void EncodeUniform(uint32_t symbol, uint32_t count) { Encode(symbol, 1, count); }
+
+    void EncodeBit(uint16_t& prob, int bit) {
+        if (bit == 0) {
+            Encode(0, prob, PROB_ONE);
+            prob += (PROB_ONE - prob) >> PROB_SHIFT;
+        } else {
+            Encode(prob, PROB_ONE - prob, PROB_ONE);
+            prob -= prob >> PROB_SHIFT;
+        }
+    }
+
+    std::vector<uint8_t> Finish() {
+        // Pick the value inside [low, low + range) with the most trailing zero bits,
+        // so the flushed tail is mostly zero bytes that can be dropped.
+        for (int bits = 32; bits > 0; bits--) {
+            uint64_t mask = (1ull << bits) - 1;
+            uint64_t v = (low + mask) & ~mask;
+            if (v < low + range) { low = v; break; }
+        }
+        for (int i = 0; i < 5; i++) ShiftLow();
+
+        // The first byte is always 0 and the decoder pads with zeros, so drop both ends
+        out.erase(out.begin());
+        while (!out.empty() && out.back() == 0) out.pop_back();
+        return out;
+    }
+
+private:
+    uint64_t low;
+    uint32_t range;
+    uint8_t cache;
+    uint64_t cacheSize;
+    std::vector<uint8_t> out;
+
+    void ShiftLow() {
+        if ((uint32_t)low < 0xFF000000u || (low >> 32) != 0) {
+            uint8_t carry = (uint8_t)(low >> 32);
+            uint8_t temp = cache;
+            do {
+                out.push_back((uint8_t)(temp + carry));
+                temp = 0xFF;
+            } while (--cacheSize != 0);
+            cache = (uint8_t)(low >> 24);
+        }
+        cacheSize++;
+        low = (low & 0x00FFFFFFu) << 8;
+    }
+};
+
+class RangeDecoder {
+public:
+    explicit RangeDecoder(const std::vector<uint8_t>& bytes) : data(bytes), pos(0), code(0), range(0xFFFFFFFFu) {
+        for (int i = 0; i < 4; i++) code = (code << 8) | Next();
+    }
+
+    // Two-step decode: look up the symbol's cumulative frequency, then consume it
+    uint32_t GetFreq(uint32_t total) {
+        range /= total;
+        uint32_t v = code / range;
+        return v < total ? v : total - 1;
+    }
+
+    void Consume(uint32_t start, uint32_t size) {
+        code -= start * range;
+        range *= size;
+        while (range < RC_TOP) { code = (code << 8) | Next(); range <<= 8; }
+    }
+
+    uint32_t DecodeUniform(uint32_t count) {
+        uint32_t symbol = GetFreq(count);
+        Consume(symbol, 1);
+        return symbol;
+    }
+
+    int DecodeBit(uint16_t& prob) {
+        uint32_t f = GetFreq(PROB_ONE);
+        if (f < prob) {
+            Consume(0, prob);
+            prob += (PROB_ONE - prob) >> PROB_SHIFT;
+            return 0;
+        }
+        Consume(prob, PROB_ONE - prob);
+        prob -= prob >> PROB_SHIFT;
+        return 1;
+    }
+
+    // Bytes read past the end (the zeros the encoder stripped). A valid code needs only the
+    // flush's few; far more means the code was cut short.
+    size_t Padding() const { return pos > data.size() ? pos - data.size() : 0; }
+
+private:
+    const std::vector<uint8_t>& data;
+    size_t pos;
+    uint32_t code;
+    uint32_t range;
+
+    uint8_t Next() {
+        uint8_t b = pos < data.size() ? data[pos] : 0; // Trailing zeros were stripped by the encoder
+        pos++;
+        return b;
+    }
+};
+
+// --- Models ---
+// Cage sums: prior from the number of distinct-digit combinations reaching each sum
+// (integer-only, so identical on every platform), plus a floor for repeated digits,
+// which the generator allows when a cage spans several rows/boxes.
+struct SumModel {
+    uint32_t cum[256];
+    uint32_t freq[256];
+    uint32_t total;
+    int minSum;
+    int count;
+
+    explicit SumModel(int cells) {
+        // ways[k][s]: number of k-subsets of 1..9 summing to s
+        static int ways[10][46];
+        static bool built = false;
+        if (!built) {
+            ways[0][0] = 1;
+            for (int d = 1; d <= 9; d++) {
+                for (int k = 9; k >= 1; k--) {
+                    for (int sum = 45; sum >= d; sum--) ways[k][sum] += ways[k - 1][sum - d];
+                }
+            }
+            built = true;
+        }
+
+        minSum = cells;
+        count = 8 * cells + 1; // Sums from cells..9*cells
+        total = 0;
+        for (int i = 0; i < count; i++) {
+            int sum = minSum + i;
+            int combos = (cells <= 9 && sum <= 45) ? ways[cells][sum] : 0;
+            freq[i] = 1 + 64 * (uint32_t)combos;
+            cum[i] = total;
+            total += freq[i];
+        }
+    }
+};
+
+// Cage partition: one "same cage" bit per right/down edge, in row-major order.
+// Encoder and decoder grow the same union-find so the context can include the size of the
+// cage fragment the cell already belongs to (fragments rarely keep growing past the cap).
+struct EdgeModel {
+    uint16_t prob[2][5][2];
+    int parent[81];
+    int size[81];
+
+    EdgeModel() {
+        for (int i = 0; i < 81; i++) { parent[i] = i; size[i] = 1; }
+        for (auto& a : prob) for (auto& b : a) for (auto& p : b) p = PROB_ONE / 2;
+    }
+
+    int Find(int x) {
+        while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+        return x;
+    }
+
+    void Join(int a, int b) {
+        a = Find(a); b = Find(b);
+        if (a == b) return;
+        parent[a] = b;
+        size[b] += size[a];
+    }
+
+    // 'attached': the neighbour already belongs to a multi-cell fragment
+    uint16_t& Context(int dir, int cell, int neighbor) {
+        int fragment = size[Find(cell)];
+        if (fragment > 4) fragment = 4;
+        int attached = size[Find(neighbor)] > 1 ? 1 : 0;
+        return prob[dir][fragment][attached];
+    }
+};
+
+// Given digits: only digits still possible next to earlier givens (row/col/box and cage sum)
+struct GivenModel {
+    int rowUsed[9], colUsed[9], boxUsed[9];
+    int cageLeft[81];  // Sum not yet covered by earlier givens
+    int cageCells[81]; // Cells not yet given
+
+    GivenModel(const KillerPuzzle& p) {
+        for (int i = 0; i < 9; i++) rowUsed[i] = colUsed[i] = boxUsed[i] = 0;
+        for (int c = 0; c < p.cageCount; c++) { cageLeft[c] = p.cageSum[c]; cageCells[c] = 0; }
+        for (int i = 0; i < 81; i++) cageCells[p.cageOf[i]]++;
+    }
+
+    int Candidates(const KillerPuzzle& p, int index) const {
+        int box = ((index / 9) / 3) * 3 + (index % 9) / 3;
+        int mask = 0x1FF & ~(rowUsed[index / 9] | colUsed[index % 9] | boxUsed[box]);
+        int cage = p.cageOf[index];
+        int others = cageCells[cage] - 1;
+        int lo = cageLeft[cage] - 9 * others;
+        int hi = cageLeft[cage] - others;
+        for (int d = 1; d <= 9; d++) {
+            if (d < lo || d > hi) mask &= ~(1 << (d - 1));
+        }
+        return mask ? mask : 0x1FF; // Inconsistent input: fall back to all digits
+    }
+
+    void Place(const KillerPuzzle& p, int index, int d) {
+        int bit = 1 << (d - 1);
+        int box = ((index / 9) / 3) * 3 + (index % 9) / 3;
+        rowUsed[index / 9] |= bit;
+        colUsed[index % 9] |= bit;
+        boxUsed[box] |= bit;
+        cageLeft[p.cageOf[index]] -= d;
+        cageCells[p.cageOf[index]]--;
+    }
+};
+
+static int RankInMask(int mask, int d) {
+    int rank = 0;
+    for (int k = 1; k < d; k++) if (mask & (1 << (k - 1))) rank++;
+    return rank;
+}
+
+static int DigitAtRank(int mask, int rank) {
+    for (int d = 1; d <= 9; d++) {
+        if (!(mask & (1 << (d - 1)))) continue;
+        if (rank-- == 0) return d;
+    }
+    return 1;
+}
+
+static int CountBits(int mask) {
+    int n = 0;
+    while (mask) { mask &= mask - 1; n++; }
+    return n;
+}
+
+const int MAX_CAGE_CELLS = 28; // Keeps 9*cells in a byte and the model total under 16 bits
+
+static uint32_t Fnv(uint32_t h, const void* data, size_t size) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) { h ^= p[i]; h *= 16777619u; }
+    return h;
+}
+
+static uint8_t KillerCheck(const KillerPuzzle& p, int difficulty) {
+    uint32_t h = 2166136261u;
+    h = Fnv(h, &difficulty, sizeof(difficulty));
+    h = Fnv(h, p.cageOf, 81);
+    h = Fnv(h, p.cageSum, p.cageCount);
+    h = Fnv(h, p.given, 81);
+    return (uint8_t)(h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24));
+}
+
+// --- Base64url ---
+static std::string ToBase64Url(const std::vector<uint8_t>& bytes) {
+    std::string s;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (uint8_t b : bytes) {
+        acc = (acc << 8) | b;
+        bits += 8;
+        while (bits >= 6) { bits -= 6; s += BASE64URL[(acc >> bits) & 63]; }
+    }
+    if (bits > 0) s += BASE64URL[(acc << (6 - bits)) & 63];
+    return s;
+}
+
+static bool FromBase64Url(const std::string& s, size_t start, std::vector<uint8_t>& bytes) {
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = start; i < s.size(); i++) {
+        const char* at = strchr(BASE64URL, s[i]);
+        if (!at || s[i] == '\0') return false;
+        acc = (acc << 6) | (uint32_t)(at - BASE64URL);
+        bits += 6;
+        if (bits >= 8) { bits -= 8; bytes.push_back((uint8_t)(acc >> bits)); }
+    }
+    return true;
+}
+
+// --- Killer ---
+std::string EncodeKillerCode(const KillerPuzzle& source, int difficulty) {
+    KillerPuzzle p = source;
+    NormalizeCageOrder(p);
+
+    int cageSize[81] = {0};
+    for (int i = 0; i < 81; i++) cageSize[p.cageOf[i]]++;
+
+    RangeEncoder rc;
+    rc.EncodeUniform(CODE_VERSION, 4);
+    rc.EncodeUniform((uint32_t)difficulty & 3, 4);
+
+    // 1. Cage partition
+    EdgeModel edges;
+    for (int i = 0; i < 81; i++) {
+        int r = i / 9, c = i % 9;
+        if (c < 8) {
+            int right = (p.cageOf[i + 1] == p.cageOf[i]) ? 1 : 0;
+            rc.EncodeBit(edges.Context(0, i, i + 1), right);
+            if (right) edges.Join(i, i + 1);
+        }
+        if (r < 8) {
+            int down = (p.cageOf[i + 9] == p.cageOf[i]) ? 1 : 0;
+            rc.EncodeBit(edges.Context(1, i, i + 9), down);
+            if (down) edges.Join(i, i + 9);
+        }
+    }
+
+    // 2. Sums, in cage order
+    for (int cage = 0; cage < p.cageCount; cage++) {
+        if (cageSize[cage] > MAX_CAGE_CELLS) return "";
+        SumModel model(cageSize[cage]);
+        int symbol = p.cageSum[cage] - model.minSum;
+        if (symbol < 0 || symbol >= model.count) return "";
+        rc.Encode(model.cum[symbol], model.freq[symbol], model.total);
+    }
+
+    // 3. Givens (mask is very skewed, digits picked among the remaining candidates)
+    uint16_t givenProb = PROB_ONE / 2;
+    GivenModel givens(p);
+    for (int i = 0; i < 81; i++) {
+        rc.EncodeBit(givenProb, p.given[i] != 0);
+        if (p.given[i] == 0) continue;
+        int mask = givens.Candidates(p, i);
+        if (!(mask & (1 << (p.given[i] - 1)))) return "";
+        rc.EncodeUniform(RankInMask(mask, p.given[i]), CountBits(mask));
+        givens.Place(p, i, p.given[i]);
+    }
+
+    rc.EncodeUniform(KillerCheck(p, difficulty & 3), 256);
+    return "K" + ToBase64Url(rc.Finish());
+}
+
+bool DecodeKillerCode(const std::string& code, KillerPuzzle& out, int& difficulty) {
+    std::vector<uint8_t> bytes;
+    if (code.empty() || code[0] != 'K' || !FromBase64Url(code, 1, bytes)) return false;
+
+    RangeDecoder rc(bytes);
+    if (rc.DecodeUniform(4) != CODE_VERSION) return false;
+    int diff = (int)rc.DecodeUniform(4);
+
+    // 1. Edges -> union-find -> cages numbered by first appearance
+    EdgeModel edges;
+    for (int i = 0; i < 81; i++) {
+        int r = i / 9, c = i % 9;
+        if (c < 8 && rc.DecodeBit(edges.Context(0, i, i + 1))) edges.Join(i, i + 1);
+        if (r < 8 && rc.DecodeBit(edges.Context(1, i, i + 9))) edges.Join(i, i + 9);
+    }
+
+    KillerPuzzle p;
+    int label[81];
+    int cageSize[81] = {0};
+    for (int i = 0; i < 81; i++) label[i] = -1;
+    p.cageCount = 0;
+    for (int i = 0; i < 81; i++) {
+        int root = edges.Find(i);
+        if (label[root] == -1) label[root] = p.cageCount++;
+        p.cageOf[i] = (uint8_t)label[root];
+        cageSize[p.cageOf[i]]++;
+    }
+
+    // 2. Sums
+    for (int cage = 0; cage < p.cageCount; cage++) {
+        if (cageSize[cage] > MAX_CAGE_CELLS) return false;
+        SumModel model(cageSize[cage]);
+        uint32_t f = rc.GetFreq(model.total);
+        int symbol = 0;
+        while (symbol + 1 < model.count && model.cum[symbol + 1] <= f) symbol++;
+        rc.Consume(model.cum[symbol], model.freq[symbol]);
+        p.cageSum[cage] = (uint8_t)(model.minSum + symbol);
+    }
+
+    // 3. Givens
+    uint16_t givenProb = PROB_ONE / 2;
+    GivenModel givens(p);
+    for (int i = 0; i < 81; i++) {
+        p.given[i] = 0;
+        if (!rc.DecodeBit(givenProb)) continue;
+        int mask = givens.Candidates(p, i);
+        p.given[i] = (uint8_t)DigitAtRank(mask, (int)rc.DecodeUniform(CountBits(mask)));
+        givens.Place(p, i, p.given[i]);
+    }
+
+    if (rc.DecodeUniform(256) != KillerCheck(p, diff) || rc.Padding() > MAX_PADDING) return false;
+
+    out = p;
+    difficulty = diff;
+    return true;
+}
+
+// --- Memory ---
+std::string EncodeMemoryCode(int difficulty, uint32_t seed) {
+    RangeEncoder rc;
+    rc.EncodeUniform(CODE_VERSION, 4);
+    rc.EncodeUniform((uint32_t)difficulty & 3, 4);
+    rc.EncodeUniform(seed >> 16, 65536);
+    rc.EncodeUniform(seed & 0xFFFF, 65536);
+    rc.EncodeUniform((seed ^ (seed >> 8) ^ (seed >> 16) ^ (seed >> 24) ^ (uint32_t)difficulty) & 0xFF, 256);
+    return "M" + ToBase64Url(rc.Finish());
+}
+
+bool DecodeMemoryCode(const std::string& code, int& difficulty, uint32_t& seed) {
+    std::vector<uint8_t> bytes;
+    if (code.empty() || code[0] != 'M' || !FromBase64Url(code, 1, bytes)) return false;
+
+    RangeDecoder rc(bytes);
+    if (rc.DecodeUniform(4) != CODE_VERSION) return false;
+    uint32_t diff = rc.DecodeUniform(4);
+    uint32_t s = rc.DecodeUniform(65536) << 16;
+    s |= rc.DecodeUniform(65536);
+    uint32_t check = rc.DecodeUniform(256);
+    if (check != ((s ^ (s >> 8) ^ (s >> 16) ^ (s >> 24) ^ diff) & 0xFF)) return false;
+
+    difficulty = (int)diff;
+    seed = s;
+    return true;
+}
+
+std::string ExtractPuzzleCode(const char* text) {
+    if (!text) return "";
+    std::string s(text);
+
+    // Share links: take the value of the "p" query parameter
+    size_t q = s.find("?p=");
+    if (q == std::string::npos) q = s.find("&p=");
+    if (q != std::string::npos) s = s.substr(q + 3);
+
+    size_t begin = 0;
+    while (begin < s.size() && (s[begin] == ' ' || s[begin] == '\t' || s[begin] == '\n' || s[begin] == '\r')) begin++;
+    size_t end = begin;
+    while (end < s.size() && strchr(BASE64URL, s[end]) && s[end] != '\0') end++;
+    return s.substr(begin, end - begin);
+}
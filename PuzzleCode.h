@@ -0,0 +1,23 @@
+#ifndef PUZZLE_CODE_H
+#define PUZZLE_CODE_H
+
+#include "KillerPuzzle.h"
+#include <string>
+#include <cstdint>
+
+// --- Shareable puzzle codes ---
+// URL-safe strings ("K..." for Killer Sudoku, "M..." for Memory) that fully describe a board.
+// Killer codes range-code the cage partition (as same-cage edge bits with adaptive
+// probabilities), the cage sums and the givens. The solution is not stored, it is re-derived
+// by SolveKiller on load. Memory codes are just difficulty + shuffle seed.
+
+std::string EncodeKillerCode(const KillerPuzzle& puzzle, int difficulty);
+bool DecodeKillerCode(const std::string& code, KillerPuzzle& puzzle, int& difficulty);
+
+std::string EncodeMemoryCode(int difficulty, uint32_t seed);
+bool DecodeMemoryCode(const std::string& code, int& difficulty, uint32_t& seed);
+
+// Accepts a bare code or a full share link containing "?p=<code>"
+std::string ExtractPuzzleCode(const char* text);
+
+#endif
@@ -0,0 +1,264 @@
+#include "PuzzleFingerprint.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <cstring>
+
+// Constants
+const int MAX_LINE_ORDERS = 64; // Per axis; see CanonicalizeKiller in the header
+const char* RECENT_FILTER_FILE = "recent.bin";
+const uint16_t RECENT_FILTER_VERSION = 1;
+
+// A line (row or column) ordering: order[newLine] = oldLine
+struct LineOrder {
+    uint8_t order[9];
+};
+
+// Sorted cell keys of one line: invariant under permutations of the other axis
+struct LineSig {
+    uint32_t keys[9];
+    bool operator<(const LineSig& o) const { return memcmp(keys, o.keys, sizeof(keys)) < 0; }
+    bool operator==(const LineSig& o) const { return memcmp(keys, o.keys, sizeof(keys)) == 0; }
+};
+
+static bool SameBandSig(const LineSig* sigs, const uint8_t* a, const uint8_t* b) {
+    for (int k = 0; k < 3; k++) if (!(sigs[a[k]] == sigs[b[k]])) return false;
+    return true;
+}
+
+static bool BandSigLess(const LineSig* sigs, const uint8_t* a, const uint8_t* b) {
+    for (int k = 0; k < 3; k++) {
+        if (sigs[a[k]] < sigs[b[k]]) return true;
+        if (sigs[b[k]] < sigs[a[k]]) return false;
+    }
+    return false;
+}
+
+// Sorts lines inside each band and the bands themselves by signature, then expands every
+// ordering that only differs by swapping equal-signature lines/bands. Stops at MAX_LINE_ORDERS
+// and clears 'complete' if there were more.
+static int OrderLines(const LineSig* sigs, LineOrder* out, bool& complete) {
+    uint8_t bands[3][3];
+    for (int b = 0; b < 3; b++) {
+        for (int k = 0; k < 3; k++) bands[b][k] = (uint8_t)(b * 3 + k);
+        std::sort(bands[b], bands[b] + 3, [&](uint8_t x, uint8_t y) { return sigs[x] < sigs[y]; });
+    }
+
+    // Orders of each band's lines that keep the sorted signature sequence (usually just one)
+    uint8_t lineOrders[3][6][3];
+    int lineOrderCount[3];
+    for (int b = 0; b < 3; b++) {
+        uint8_t perm[3];
+        memcpy(perm, bands[b], 3);
+        std::sort(perm, perm + 3);
+        lineOrderCount[b] = 0;
+        do {
+            if (sigs[perm[0]] == sigs[bands[b][0]] && sigs[perm[1]] == sigs[bands[b][1]] && sigs[perm[2]] == sigs[bands[b][2]]) {
+                memcpy(lineOrders[b][lineOrderCount[b]++], perm, 3);
+            }
+        } while (std::next_permutation(perm, perm + 3));
+    }
+
+    int sortedBands[3] = {0, 1, 2};
+    std::sort(sortedBands, sortedBands + 3, [&](int x, int y) { return BandSigLess(sigs, bands[x], bands[y]); });
+
+    int count = 0;
+    int bandPerm[3] = {0, 1, 2};
+    do {
+        bool keepsOrder = true;
+        for (int k = 0; k < 3; k++) {
+            if (!SameBandSig(sigs, bands[bandPerm[k]], bands[sortedBands[k]])) keepsOrder = false;
+        }
+        if (!keepsOrder) continue;
+
+        for (int i0 = 0; i0 < lineOrderCount[bandPerm[0]]; i0++) {
+            for (int i1 = 0; i1 < lineOrderCount[bandPerm[1]]; i1++) {
+                for (int i2 = 0; i2 < lineOrderCount[bandPerm[2]]; i2++) {
+                    if (count == MAX_LINE_ORDERS) {
+                        complete = false;
+                        return count;
+                    }
+                    const int picks[3] = {i0, i1, i2};
+                    for (int b = 0; b < 3; b++) {
+                        memcpy(out[count].order + b * 3, lineOrders[bandPerm[b]][picks[b]], 3);
+                    }
+                    count++;
+                }
+            }
+        }
+    } while (std::next_permutation(bandPerm, bandPerm + 3));
+    return count;
+}
+
+static bool PuzzleLess(const KillerPuzzle& a, const KillerPuzzle& b) {
+    int c = memcmp(a.cageOf, b.cageOf, 81);
+    if (c != 0) return c < 0;
+    c = memcmp(a.given, b.given, 81);
+    if (c != 0) return c < 0;
+    return memcmp(a.cageSum, b.cageSum, a.cageCount) < 0; // Same partition => same cageCount
+}
+
+// Best arrangement of one variant (already transposed/complemented as needed)
+static void CanonicalizeVariant(const KillerPuzzle& q, KillerPuzzle& best, bool& haveBest, bool& complete) {
+    int cageSize[81] = {0};
+    for (int i = 0; i < 81; i++) cageSize[q.cageOf[i]]++;
+
+    uint32_t key[81];
+    for (int i = 0; i < 81; i++) {
+        key[i] = ((uint32_t)cageSize[q.cageOf[i]] << 16) | ((uint32_t)q.cageSum[q.cageOf[i]] << 8) | q.given[i];
+    }
+
+    LineSig rowSig[9], colSig[9];
+    for (int a = 0; a < 9; a++) {
+        for (int b = 0; b < 9; b++) {
+            rowSig[a].keys[b] = key[a * 9 + b];
+            colSig[a].keys[b] = key[b * 9 + a];
+        }
+        std::sort(rowSig[a].keys, rowSig[a].keys + 9);
+        std::sort(colSig[a].keys, colSig[a].keys + 9);
+    }
+
+    LineOrder rowOrders[MAX_LINE_ORDERS], colOrders[MAX_LINE_ORDERS];
+    int rowCount = OrderLines(rowSig, rowOrders, complete);
+    int colCount = OrderLines(colSig, colOrders, complete);
+
+    KillerPuzzle candidate;
+    for (int ro = 0; ro < rowCount; ro++) {
+        for (int co = 0; co < colCount; co++) {
+            for (int r = 0; r < 9; r++) {
+                for (int c = 0; c < 9; c++) {
+                    int src = rowOrders[ro].order[r] * 9 + colOrders[co].order[c];
+                    candidate.cageOf[r * 9 + c] = q.cageOf[src];
+                    candidate.given[r * 9 + c] = q.given[src];
+                }
+            }
+            memcpy(candidate.cageSum, q.cageSum, sizeof(q.cageSum));
+            candidate.cageCount = q.cageCount;
+            NormalizeCageOrder(candidate);
+            if (!haveBest || PuzzleLess(candidate, best)) {
+                best = candidate;
+                haveBest = true;
+            }
+        }
+    }
+}
+
+KillerPuzzle CanonicalizeKiller(const KillerPuzzle& puzzle, bool* complete) {
+    KillerPuzzle best;
+    bool haveBest = false;
+    bool searched = true;
+
+    int cageSize[81] = {0};
+    for (int i = 0; i < 81; i++) cageSize[puzzle.cageOf[i]]++;
+
+    for (int variant = 0; variant < 4; variant++) {
+        bool transpose = (variant & 1) != 0;
+        bool complement = (variant & 2) != 0;
+
+        KillerPuzzle q;
+        q.cageCount = puzzle.cageCount;
+        for (int c = 0; c < puzzle.cageCount; c++) {
+            q.cageSum[c] = complement ? (uint8_t)(10 * cageSize[c] - puzzle.cageSum[c]) : puzzle.cageSum[c];
+        }
+        for (int i = 0; i < 81; i++) {
+            int src = transpose ? (i % 9) * 9 + i / 9 : i;
+            q.cageOf[i] = puzzle.cageOf[src];
+            int g = puzzle.given[src];
+            q.given[i] = (complement && g) ? (uint8_t)(10 - g) : (uint8_t)g;
+        }
+        CanonicalizeVariant(q, best, haveBest, searched);
+    }
+    if (complete) *complete = searched;
+    return best;
+}
+
+static uint64_t Mix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27; x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t HashPuzzle(const KillerPuzzle& p) {
+    uint64_t h = 1469598103934665603ull; // FNV-1a 64
+    auto feed = [&](const uint8_t* bytes, int n) {
+        for (int i = 0; i < n; i++) { h ^= bytes[i]; h *= 1099511628211ull; }
+    };
+    feed(p.cageOf, 81);
+    feed(p.given, 81);
+    feed(p.cageSum, p.cageCount);
+    return Mix64(h);
+}
+
+uint64_t FingerprintKiller(const KillerPuzzle& puzzle) {
+    return HashPuzzle(CanonicalizeKiller(puzzle));
+}
+
+uint64_t HashKiller(const KillerPuzzle& puzzle) {
+    KillerPuzzle p = puzzle;
+    NormalizeCageOrder(p);
+    return HashPuzzle(p);
+}
+
+// --- RecentPuzzleFilter ---
+void RecentPuzzleFilter::Clear() {
+    memset(current, 0, sizeof(current));
+    memset(previous, 0, sizeof(previous));
+    currentCount = 0;
+}
+
+bool RecentPuzzleFilter::Test(const uint8_t* bits, uint64_t fingerprint) {
+    // Double hashing: probe i is h1 + i*h2
+    uint32_t h1 = (uint32_t)fingerprint;
+    uint32_t h2 = (uint32_t)(fingerprint >> 32) | 1;
+    for (int i = 0; i < HASHES; i++) {
+        uint32_t bit = (h1 + i * h2) % BITS;
+        if (!(bits[bit >> 3] & (1 << (bit & 7)))) return false;
+    }
+    return true;
+}
+
+bool RecentPuzzleFilter::Contains(uint64_t fingerprint) const {
+    return Test(current, fingerprint) || Test(previous, fingerprint);
+}
+
+void RecentPuzzleFilter::Insert(uint64_t fingerprint) {
+    if (currentCount >= CAPACITY) {
+        memcpy(previous, current, sizeof(current));
+        memset(current, 0, sizeof(current));
+        currentCount = 0;
+    }
+    uint32_t h1 = (uint32_t)fingerprint;
+    uint32_t h2 = (uint32_t)(fingerprint >> 32) | 1;
+    for (int i = 0; i < HASHES; i++) {
+        uint32_t bit = (h1 + i * h2) % BITS;
+        current[bit >> 3] |= (uint8_t)(1 << (bit & 7));
+    }
+    currentCount++;
+}
+
+bool RecentPuzzleFilter::Load() {
+    Clear();
+    uint16_t version = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadSnapshotFile(RECENT_FILTER_FILE, SNAP_RECENT, version, payload)) return false;
+    if (version != RECENT_FILTER_VERSION) return false;
+
+    ByteReader in(payload.data(), payload.size());
+    int count = (int)in.U32();
+    in.Bytes(current, sizeof(current));
+    in.Bytes(previous, sizeof(previous));
+    if (!in.Ok() || !in.AtEnd() || count < 0 || count > CAPACITY) {
+        Clear();
+        return false;
+    }
+    currentCount = count;
+    return true;
+}
+
+void RecentPuzzleFilter::Save() {
+    ByteWriter out;
+    out.U32((uint32_t)currentCount);
+    out.Bytes(current, sizeof(current));
+    out.Bytes(previous, sizeof(previous));
+    WriteSnapshotFile(RECENT_FILTER_FILE, SNAP_RECENT, RECENT_FILTER_VERSION, out);
+}
@@ -0,0 +1,54 @@
+#ifndef PUZZLE_FINGERPRINT_H
+#define PUZZLE_FINGERPRINT_H
+
+#include "KillerPuzzle.h"
+#include <cstdint>
+
+// --- Puzzle identity across symmetries ---
+// Two Killer puzzles are "the same" if one maps onto the other by transposition,
+// band/stack permutations, row/column permutations inside bands/stacks, or digit
+// complement (d -> 10-d, sums -> 10*cells - sum). Complement is the only digit
+// relabeling that keeps cage sums consistent.
+
+// Canonical representative of the puzzle's symmetry class. Rows and columns are ordered
+// by permutation-invariant signatures; only lines with equal signatures are tried both ways.
+// LIMIT: at most 64 orderings per axis are tried (all 1296 would be 1296^2 boards per variant).
+// Boards whose lines mostly share a signature, e.g. every cell a one-cell cage, go past it;
+// 'complete' (if given) is then false and the result is the best of the orderings tried, so
+// symmetric copies of such a board may canonicalize (and fingerprint) differently. The
+// generator never makes one: tests/PuzzleFingerprintTest.cpp checks both sides of the limit.
+KillerPuzzle CanonicalizeKiller(const KillerPuzzle& puzzle, bool* complete = nullptr);
+
+// 64-bit hash of the canonical form (same LIMIT)
+uint64_t FingerprintKiller(const KillerPuzzle& puzzle);
+
+// 64-bit hash of this exact board: its symmetric copies hash differently. For puzzles
+// derived from a seed (PuzzleTransform.h), which share the seed's fingerprint on purpose.
+uint64_t HashKiller(const KillerPuzzle& puzzle);
+
+// Bloom filter of recently played puzzles (two rotating generations, ~1 KB total).
+// False positives only cost a regeneration; false negatives can't happen until an
+// entry ages out after roughly 2 * CAPACITY newer inserts (KillerSudoku.cpp inserts two keys
+// per game, so about CAPACITY games).
+class RecentPuzzleFilter {
+public:
+    static const int BITS = 4096;    // Per generation
+    static const int HASHES = 5;
+    static const int CAPACITY = 400; // Inserts before the generations rotate (~1% false positives)
+
+    void Clear();
+    bool Contains(uint64_t fingerprint) const;
+    void Insert(uint64_t fingerprint);
+
+    bool Load();  // From save storage, false if missing/corrupt (filter is then cleared)
+    void Save();
+
+private:
+    uint8_t current[BITS / 8];
+    uint8_t previous[BITS / 8];
+    int currentCount;
+
+    static bool Test(const uint8_t* bits, uint64_t fingerprint);
+};
+
+#endif
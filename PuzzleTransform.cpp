@@ -0,0 +1,104 @@
+#include "PuzzleTransform.h"
+#include <algorithm>
+#include <cstring>
+
+// Constants
+const int SWAP_ATTEMPTS = 12; // Random row/band/column/stack swaps tried per derivation
+
+// Moves cells: new cell i takes old cell src[i]
+static void MoveCells(const SolvedPuzzle& in, const int* src, SolvedPuzzle& out) {
+    out.puzzle.cageCount = in.puzzle.cageCount;
+    memcpy(out.puzzle.cageSum, in.puzzle.cageSum, sizeof(in.puzzle.cageSum));
+    for (int i = 0; i < 81; i++) {
+        out.puzzle.cageOf[i] = in.puzzle.cageOf[src[i]];
+        out.puzzle.given[i] = in.puzzle.given[src[i]];
+        out.solution[i] = in.solution[src[i]];
+    }
+}
+
+// Every cage must still be one orthogonally connected shape
+static bool CagesConnected(const KillerPuzzle& p) {
+    int size[81] = {0};
+    int first[81];
+    for (int i = 80; i >= 0; i--) { size[p.cageOf[i]]++; first[p.cageOf[i]] = i; }
+
+    bool seen[81] = {false};
+    int stack[81];
+    for (int c = 0; c < p.cageCount; c++) {
+        int top = 0, reached = 0;
+        stack[top++] = first[c];
+        seen[first[c]] = true;
+        while (top > 0) {
+            int cell = stack[--top];
+            reached++;
+            int r = cell / 9, col = cell % 9;
+            const int next[4] = { r > 0 ? cell - 9 : -1, r < 8 ? cell + 9 : -1,
+                                  col > 0 ? cell - 1 : -1, col < 8 ? cell + 1 : -1 };
+            for (int n : next) {
+                if (n >= 0 && !seen[n] && p.cageOf[n] == c) { seen[n] = true; stack[top++] = n; }
+            }
+        }
+        if (reached != size[c]) return false;
+    }
+    return true;
+}
+
+// Swaps rows a and b (or columns, if 'columns') of the cell mapping
+static void SwapLines(int* src, int a, int b, bool columns) {
+    for (int k = 0; k < 9; k++) {
+        int x = columns ? k * 9 + a : a * 9 + k;
+        int y = columns ? k * 9 + b : b * 9 + k;
+        std::swap(src[x], src[y]);
+    }
+}
+
+SolvedPuzzle DeriveKiller(const SolvedPuzzle& seed, std::mt19937& rng) {
+    // 1. Dihedral part (transpose + reversals): always keeps cages connected
+    int src[81];
+    bool transpose = rng() & 1, flipRows = rng() & 1, flipCols = rng() & 1;
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int sr = flipRows ? 8 - r : r;
+            int sc = flipCols ? 8 - c : c;
+            src[r * 9 + c] = transpose ? sc * 9 + sr : sr * 9 + sc;
+        }
+    }
+    SolvedPuzzle current;
+    MoveCells(seed, src, current);
+
+    // 2. Line swaps, kept only when no cage gets torn apart
+    SolvedPuzzle trial;
+    int identity[81];
+    for (int i = 0; i < 81; i++) identity[i] = i;
+    for (int attempt = 0; attempt < SWAP_ATTEMPTS; attempt++) {
+        int map[81];
+        memcpy(map, identity, sizeof(map));
+        bool columns = rng() & 1;
+        if (rng() & 1) {
+            int band = rng() % 3, a = rng() % 3, b = (a + 1 + rng() % 2) % 3; // Two lines in one band
+            SwapLines(map, band * 3 + a, band * 3 + b, columns);
+        } else {
+            int a = rng() % 3, b = (a + 1 + rng() % 2) % 3; // Two whole bands
+            for (int k = 0; k < 3; k++) SwapLines(map, a * 3 + k, b * 3 + k, columns);
+        }
+        MoveCells(current, map, trial);
+        if (CagesConnected(trial.puzzle)) current = trial;
+    }
+
+    // 3. Digits: complement, the one relabeling that keeps every cage sum consistent (any
+    // other permutation changes the sums, and with them the puzzle and its uniqueness)
+    uint8_t digitMap[10];
+    for (int d = 0; d <= 9; d++) digitMap[d] = (uint8_t)d;
+    if (rng() & 1) {
+        for (int d = 1; d <= 9; d++) digitMap[d] = (uint8_t)(10 - d);
+    }
+    for (int i = 0; i < 81; i++) {
+        current.solution[i] = digitMap[current.solution[i]];
+        current.puzzle.given[i] = digitMap[current.puzzle.given[i]];
+    }
+    for (int c = 0; c < current.puzzle.cageCount; c++) current.puzzle.cageSum[c] = 0;
+    for (int i = 0; i < 81; i++) current.puzzle.cageSum[current.puzzle.cageOf[i]] += current.solution[i];
+
+    NormalizeCageOrder(current.puzzle);
+    return current;
+}
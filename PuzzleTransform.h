@@ -0,0 +1,21 @@
+#ifndef PUZZLE_TRANSFORM_H
+#define PUZZLE_TRANSFORM_H
+
+#include "KillerPuzzle.h"
+#include <random>
+
+// A puzzle together with its (unique) solution
+struct SolvedPuzzle {
+    KillerPuzzle puzzle;
+    uint8_t solution[81];
+};
+
+// --- Instant puzzle derivation ---
+// Produces a fresh-looking puzzle from a verified one in O(81) per move:
+// rotations/reflections, then random row swaps inside bands, band swaps and the column
+// equivalents, each kept only if every cage stays a connected shape, then digit complement.
+// These are all Sudoku symmetries, so a unique seed gives a unique puzzle of the same
+// difficulty (and the same FingerprintKiller class).
+SolvedPuzzle DeriveKiller(const SolvedPuzzle& seed, std::mt19937& rng);
+
+#endif
@@ -0,0 +1,149 @@
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const double LEVEL_DECAY = 2.0 / 3.0; // Capacity shrinks by this factor per level below the top
+const int MIN_LEVEL_CAPACITY = 2;
+const int MAX_LEVELS = 40;            // 2^40 values, far beyond any history
+
+void KllSketch::Clear() {
+    levels.assign(1, std::vector<float>());
+    count = 0;
+    minValue = 0.0f;
+    maxValue = 0.0f;
+    coin = 0x9E3779B9u;
+}
+
+int KllSketch::Capacity(int level) const {
+    int depth = (int)levels.size() - 1 - level; // 0 for the top level
+    int cap = (int)std::ceil(K * std::pow(LEVEL_DECAY, depth));
+    return cap < MIN_LEVEL_CAPACITY ? MIN_LEVEL_CAPACITY : cap;
+}
+
+int KllSketch::RetainedSize() const {
+    int n = 0;
+    for (const auto& level : levels) n += (int)level.size();
+    return n;
+}
+
+int KllSketch::TotalCapacity() const {
+    int n = 0;
+    for (int h = 0; h < (int)levels.size(); h++) n += Capacity(h);
+    return n;
+}
+
+void KllSketch::Add(float value) {
+    if (count == 0) {
+        minValue = maxValue = value;
+    } else {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    count++;
+    levels[0].push_back(value);
+    if (RetainedSize() > TotalCapacity()) Compact();
+}
+
+// Halves the lowest full level into the one above it
+void KllSketch::Compact() {
+    while (RetainedSize() > TotalCapacity()) {
+        int h = 0;
+        while (h < (int)levels.size() && (int)levels[h].size() < Capacity(h)) h++;
+        if (h == (int)levels.size()) return; // Over total but no single level full: fine for now
+        if (h + 1 == (int)levels.size()) {
+            if ((int)levels.size() >= MAX_LEVELS) return;
+            levels.push_back(std::vector<float>());
+        }
+
+        std::vector<float>& level = levels[h];
+        std::sort(level.begin(), level.end());
+        // An odd item out stays behind so the total weight is preserved exactly
+        size_t start = level.size() % 2;
+        coin ^= coin << 13; coin ^= coin >> 17; coin ^= coin << 5;
+        size_t offset = coin & 1;
+        std::vector<float>& above = levels[h + 1];
+        for (size_t i = start + offset; i < level.size(); i += 2) above.push_back(level[i]);
+        level.resize(start);
+    }
+}
+
+void KllSketch::Merge(const KllSketch& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        minValue = other.minValue;
+        maxValue = other.maxValue;
+    } else {
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+    count += other.count;
+    if (levels.size() < other.levels.size()) levels.resize(other.levels.size());
+    for (size_t h = 0; h < other.levels.size(); h++) {
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    }
+    Compact();
+}
+
+float KllSketch::Quantile(double q) const {
+    if (count == 0) return 0.0f;
+    if (q <= 0.0) return minValue;
+    if (q >= 1.0) return maxValue;
+
+    std::vector<std::pair<float, uint64_t>> weighted;
+    weighted.reserve(RetainedSize());
+    uint64_t total = 0;
+    for (size_t h = 0; h < levels.size(); h++) {
+        for (float v : levels[h]) weighted.push_back(std::make_pair(v, (uint64_t)1 << h));
+        total += levels[h].size() * ((uint64_t)1 << h);
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    double target = q * (double)total;
+    uint64_t seen = 0;
+    for (const auto& item : weighted) {
+        seen += item.second;
+        if ((double)seen >= target) return item.first;
+    }
+    return maxValue;
+}
+
+// Layout: count u32 lo/hi, min f32, max f32, coin u32, level count u8, then per level: size u16 + floats
+void KllSketch::Write(ByteWriter& out) const {
+    out.U32((uint32_t)count);
+    out.U32((uint32_t)(count >> 32));
+    out.F32(minValue);
+    out.F32(maxValue);
+    out.U32(coin);
+    out.U8((uint8_t)levels.size());
+    for (const auto& level : levels) {
+        out.U16((uint16_t)level.size());
+        for (float v : level) out.F32(v);
+    }
+}
+
+bool KllSketch::Read(ByteReader& in) {
+    uint64_t lo = in.U32();
+    uint64_t hi = in.U32();
+    float loadedMin = in.F32();
+    float loadedMax = in.F32();
+    uint32_t loadedCoin = in.U32();
+    int levelCount = in.U8();
+    if (!in.Ok() || levelCount < 1 || levelCount > MAX_LEVELS) return false;
+
+    std::vector<std::vector<float>> loaded(levelCount);
+    for (int h = 0; h < levelCount; h++) {
+        int size = in.U16();
+        if (size > 4 * K) return false; // Never legitimately this large
+        loaded[h].resize(size);
+        for (int i = 0; i < size; i++) loaded[h][i] = in.F32();
+    }
+    if (!in.Ok()) return false;
+
+    levels.swap(loaded);
+    count = lo | (hi << 32);
+    minValue = loadedMin;
+    maxValue = loadedMax;
+    coin = loadedCoin ? loadedCoin : 0x9E3779B9u;
+    return true;
+}
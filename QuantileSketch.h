@@ -0,0 +1,45 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include "Snapshot.h"
+#include <vector>
+#include <cstdint>
+
+// --- KLL quantile sketch ---
+// Streaming percentiles in bounded memory: a stack of "compactors", where level h holds
+// samples that each stand for 2^h values. When a level overflows it is sorted and every
+// other sample (random parity) is promoted, so the sketch stays around 3*K floats no
+// matter how many values were added. Sketches merge by concatenating levels.
+// Rank error is roughly 1.7/K (~2.5% for K = 64). Min and max are exact.
+class KllSketch {
+public:
+    static const int K = 64;
+
+    KllSketch() { Clear(); }
+    void Clear();
+
+    void Add(float value);
+    void Merge(const KllSketch& other);
+
+    uint64_t Count() const { return count; }
+    float Min() const { return minValue; }
+    float Max() const { return maxValue; }
+    float Quantile(double q) const; // q in [0,1]; 0 if empty
+
+    void Write(ByteWriter& out) const;
+    bool Read(ByteReader& in);
+
+private:
+    std::vector<std::vector<float>> levels;
+    uint64_t count;
+    float minValue;
+    float maxValue;
+    uint32_t coin; // xorshift state: compaction parity, saved so results are reproducible
+
+    int Capacity(int level) const;
+    int RetainedSize() const;
+    int TotalCapacity() const;
+    void Compact();
+};
+
+#endif
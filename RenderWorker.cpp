@@ -0,0 +1,93 @@
+#include "RenderWorker.h"
+#include <cstdio>
+
+#if WORKER_RENDERING
+#include <emscripten.h>
+#include <emscripten/proxying.h>
+#include <emscripten/threading.h>
+#include <atomic>
+#include <pthread.h>
+
+static pthread_t renderThread;
+static std::atomic<bool> renderThreadKnown{false};
+
+// OFFSCREENCANVASES_TO_PTHREAD=#canvas moved the canvas here; GLFW creates its context on
+// Module.canvas. GLFW also registers window/document listeners, which a worker has no
+// use for (nothing would fire on them: input comes through GameInput), so it gets inert ones.
+EM_JS(int, AdoptOffscreenCanvas, (), {
+    const transferred = GL.offscreenCanvases['canvas'];
+    if (!transferred) return 0;
+    Module.canvas = transferred.offscreenCanvas;
+    if (typeof window === 'undefined') {
+        self.window = self;
+        if (self.devicePixelRatio === undefined) self.devicePixelRatio = 1;
+    }
+    if (typeof document === 'undefined') {
+        self.document = { title: '', fullscreenElement: null, addEventListener: function() {}, removeEventListener: function() {} };
+    }
+    return 1;
+});
+
+void PrepareRenderCanvas() {
+    renderThread = pthread_self();
+    renderThreadKnown = true;
+    if (!AdoptOffscreenCanvas()) printf("No OffscreenCanvas on the render thread (link with -s OFFSCREENCANVASES_TO_PTHREAD=#canvas)\n");
+}
+
+static void RunTask(void* task) {
+    (*(const std::function<void()>*)task)();
+}
+
+static void RunPostedTask(void* task) {
+    std::function<void()>* posted = (std::function<void()>*)task;
+    (*posted)();
+    delete posted;
+}
+
+// The page thread waits until the render thread is back in its event loop, i.e. at most
+// the rest of the current frame
+void RunOnRenderThread(const std::function<void()>& task) {
+    if (!renderThreadKnown || pthread_equal(pthread_self(), renderThread)) {
+        task();
+        return;
+    }
+    if (!emscripten_proxy_sync(emscripten_proxy_get_system_queue(), renderThread, RunTask, (void*)&task)) {
+        printf("Could not reach the render thread\n");
+    }
+}
+
+void RunOnPageThread(const std::function<void()>& task) {
+    if (emscripten_is_main_runtime_thread()) {
+        task();
+        return;
+    }
+    emscripten_proxy_sync(emscripten_proxy_get_system_queue(), emscripten_main_runtime_thread_id(), RunTask, (void*)&task);
+}
+
+void PostToPageThread(std::function<void()> task) {
+    if (emscripten_is_main_runtime_thread()) {
+        task();
+        return;
+    }
+    std::function<void()>* posted = new std::function<void()>(std::move(task));
+    if (!emscripten_proxy_async(emscripten_proxy_get_system_queue(), emscripten_main_runtime_thread_id(), RunPostedTask, posted)) {
+        delete posted;
+    }
+}
+
+#else
+// One thread does both jobs
+void PrepareRenderCanvas() {}
+
+void RunOnRenderThread(const std::function<void()>& task) {
+    task();
+}
+
+void RunOnPageThread(const std::function<void()>& task) {
+    task();
+}
+
+void PostToPageThread(std::function<void()> task) {
+    task();
+}
+#endif
@@ -0,0 +1,34 @@
+#ifndef RENDER_WORKER_H
+#define RENDER_WORKER_H
+
+#include <functional>
+
+// --- Proxy-to-worker web build ---
+// Built with -DRENDER_IN_WORKER and -s PROXY_TO_PTHREAD (see README), main() and the whole
+// frame loop run on a pthread that draws into the page canvas through an OffscreenCanvas.
+// The browser main thread is left to the page: leaderboard DOM rebuilds, the name modal,
+// fetch callbacks. Whatever still crosses between the two does so explicitly:
+//   page -> game: DOM input (GameInput.h) and the JS-exported entry points (RunOnRenderThread)
+//   game -> page: the interop drain, save storage and the clipboard (PostToPageThread, RunOnPageThread)
+// In every other build these are plain calls on the one thread there is.
+
+#if defined(PLATFORM_WEB) && defined(RENDER_IN_WORKER)
+#define WORKER_RENDERING 1
+#else
+#define WORKER_RENDERING 0
+#endif
+
+// First thing in main(), before InitWindow: hands GLFW the transferred OffscreenCanvas
+void PrepareRenderCanvas();
+
+// Runs 'task' on the render thread, where the games live, and waits for it. For the
+// JS-exported entry points, which the page calls from its own thread.
+void RunOnRenderThread(const std::function<void()>& task);
+
+// Page JS state (Module, the DOM, FS/IDBFS) lives on the page thread. RunOnPageThread waits
+// (arguments may point into the caller's stack); PostToPageThread queues and returns, so a
+// busy page never holds up the frame.
+void RunOnPageThread(const std::function<void()>& task);
+void PostToPageThread(std::function<void()> task);
+
+#endif
@@ -0,0 +1,182 @@
+#include "ScoreDatabase.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+// Constants
+const char* SCORE_LOG_FILE = "scores.log";
+const char* SCORE_INDEX_FILE = "scores.idx";
+const uint16_t SCORE_INDEX_VERSION = 2;
+const uint8_t SCORE_RECORD_VERSION = 2;
+const int COMPACT_AFTER_RECORDS = 64; // Tail records replayed at startup before the index is rewritten
+const size_t MAX_NAME_LENGTH = 32;
+
+ScoreDatabase& ScoreDatabase::Get() {
+    static ScoreDatabase instance;
+    return instance;
+}
+
+bool ScoreDatabase::Better(ScoreBoard board, const ScoreEntry& a, const ScoreEntry& b) {
+    if (a.score != b.score) return (board == BOARD_MEMORY) ? a.score < b.score : a.score > b.score;
+    if (a.elapsedMs != b.elapsedMs) return a.elapsedMs < b.elapsedMs;
+    return a.timestamp < b.timestamp;
+}
+
+// Sorted insert: after every entry that is at least as good (older ties stay ahead)
+void ScoreDatabase::Place(ScoreBoard board, const ScoreEntry& entry) {
+    std::vector<ScoreEntry>& list = boards[board];
+    auto pos = std::upper_bound(list.begin(), list.end(), entry,
+                                [board](const ScoreEntry& a, const ScoreEntry& b) { return Better(board, a, b); });
+    list.insert(pos, entry);
+}
+
+// Log record: version, board, score, timestamp, [v2: elapsed ms], name length, name bytes
+void ScoreDatabase::ApplyRecord(ByteReader& record) {
+    int version = record.U8();
+    int board = record.U8();
+    ScoreEntry entry;
+    entry.score = record.I32();
+    entry.timestamp = record.U32();
+    entry.elapsedMs = (version >= 2) ? record.I32() : SCORE_NO_TIME;
+    int length = record.U8();
+    char name[256];
+    record.Bytes(name, length);
+    if (!record.Ok() || version < 1 || version > SCORE_RECORD_VERSION || board >= BOARD_COUNT) return;
+    entry.name.assign(name, length);
+    if (bulkLoading) boards[board].push_back(entry); // Sorted once at the end
+    else Place((ScoreBoard)board, entry);
+    tailRecords++;
+}
+
+void ScoreDatabase::Open() {
+    if (opened) return;
+    opened = true;
+
+    size_t logBytes = 0;
+    bool haveIndex = LoadIndex();
+    auto replay = [this](ByteReader& record) { ApplyRecord(record); };
+    if (haveIndex && ReadLogRecords(SCORE_LOG_FILE, replay, indexedLogBytes, &logBytes)) {
+        if (tailRecords >= COMPACT_AFTER_RECORDS) Compact(logBytes);
+        return;
+    }
+
+    // No usable index (first run, corrupt, or the log was replaced): rebuild from the whole log
+    for (auto& list : boards) list.clear();
+    tailRecords = 0;
+    bulkLoading = true;
+    bool haveLog = ReadLogRecords(SCORE_LOG_FILE, replay, 0, &logBytes);
+    bulkLoading = false;
+    if (!haveLog) return; // No scores yet
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        ScoreBoard board = (ScoreBoard)b;
+        std::stable_sort(boards[b].begin(), boards[b].end(),
+                         [board](const ScoreEntry& x, const ScoreEntry& y) { return Better(board, x, y); });
+    }
+    printf("Score index rebuilt from log (%d scores)\n", tailRecords);
+    Compact(logBytes);
+}
+
+// Payload: covered log bytes (u32), then per board: count (u32) and entries in rank order
+bool ScoreDatabase::LoadIndex() {
+    uint16_t version = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadSnapshotFile(SCORE_INDEX_FILE, SNAP_SCORES, version, payload)) return false;
+    if (version != SCORE_INDEX_VERSION) return false;
+
+    ByteReader in(payload.data(), payload.size());
+    size_t covered = in.U32();
+    std::vector<ScoreEntry> loaded[BOARD_COUNT];
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        uint32_t count = in.U32();
+        if (!in.Ok() || count > payload.size()) return false; // Each entry takes several bytes
+        loaded[b].resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            ScoreEntry& entry = loaded[b][i];
+            entry.score = in.I32();
+            entry.timestamp = in.U32();
+            entry.elapsedMs = in.I32();
+            int length = in.U8();
+            char name[256];
+            if (!in.Bytes(name, length)) return false;
+            entry.name.assign(name, length);
+        }
+    }
+    if (!in.Ok() || !in.AtEnd()) return false;
+
+    for (int b = 0; b < BOARD_COUNT; b++) boards[b].swap(loaded[b]);
+    indexedLogBytes = covered;
+    tailRecords = 0;
+    return true;
+}
+
+void ScoreDatabase::Compact(size_t logBytes) {
+    ByteWriter out;
+    out.U32((uint32_t)logBytes);
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        out.U32((uint32_t)boards[b].size());
+        for (const ScoreEntry& entry : boards[b]) {
+            out.I32(entry.score);
+            out.U32(entry.timestamp);
+            out.I32(entry.elapsedMs);
+            out.U8((uint8_t)entry.name.size());
+            out.Bytes(entry.name.data(), entry.name.size());
+        }
+    }
+    if (WriteSnapshotFile(SCORE_INDEX_FILE, SNAP_SCORES, SCORE_INDEX_VERSION, out)) {
+        indexedLogBytes = logBytes;
+        tailRecords = 0;
+    }
+}
+
+int ScoreDatabase::Insert(ScoreBoard board, const std::string& name, int score, int elapsedMs) {
+    Open();
+    ScoreEntry entry;
+    entry.score = score;
+    entry.elapsedMs = elapsedMs;
+    entry.timestamp = (uint32_t)time(nullptr);
+    entry.name = name.substr(0, MAX_NAME_LENGTH);
+
+    // The log is written first: if the index write below never happens, the next Open replays it
+    ByteWriter record;
+    record.U8(SCORE_RECORD_VERSION);
+    record.U8((uint8_t)board);
+    record.I32(entry.score);
+    record.U32(entry.timestamp);
+    record.I32(entry.elapsedMs);
+    record.U8((uint8_t)entry.name.size());
+    record.Bytes(entry.name.data(), entry.name.size());
+    if (!AppendLogRecord(SCORE_LOG_FILE, record)) printf("Could not write %s\n", SCORE_LOG_FILE);
+
+    int rank = RankOf(board, score, elapsedMs);
+    Place(board, entry);
+    if (++tailRecords >= COMPACT_AFTER_RECORDS) {
+        size_t logBytes = 0;
+        ReadLogRecords(SCORE_LOG_FILE, [](ByteReader&) {}, indexedLogBytes, &logBytes); // Just the size
+        Compact(logBytes);
+    }
+    return rank;
+}
+
+std::vector<ScoreEntry> ScoreDatabase::TopK(ScoreBoard board, int k) {
+    Open();
+    const std::vector<ScoreEntry>& list = boards[board];
+    size_t n = std::min(list.size(), (size_t)std::max(k, 0));
+    return std::vector<ScoreEntry>(list.begin(), list.begin() + n);
+}
+
+int ScoreDatabase::RankOf(ScoreBoard board, int score, int elapsedMs) {
+    Open();
+    ScoreEntry probe;
+    probe.score = score;
+    probe.elapsedMs = elapsedMs;
+    probe.timestamp = UINT32_MAX;
+    const std::vector<ScoreEntry>& list = boards[board];
+    auto pos = std::upper_bound(list.begin(), list.end(), probe,
+                                [board](const ScoreEntry& a, const ScoreEntry& b) { return Better(board, a, b); });
+    return (int)(pos - list.begin()) + 1;
+}
+
+int ScoreDatabase::Count(ScoreBoard board) {
+    Open();
+    return (int)boards[board].size();
+}
@@ -0,0 +1,62 @@
+#ifndef SCORE_DATABASE_H
+#define SCORE_DATABASE_H
+
+#include "Snapshot.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- Local score database (desktop leaderboard) ---
+// Backs SaveScoreToBrowser/RefreshLeaderboard when there is no browser.
+//   scores.log: append-only, per-record checksummed; the source of truth
+//   scores.idx: every board already sorted, plus how many log bytes it covers
+// Startup loads the index and replays only the log tail written after it, so it stays
+// instant after years of scores. The index is rewritten (compacted) once the tail grows.
+
+// SaveScoreToBrowser's sortOrder identifies the game: 0 = Memory (golf scoring, low is
+// better), 1 = Killer Sudoku (high is better)
+enum ScoreBoard {
+    BOARD_MEMORY = 0,
+    BOARD_SUDOKU = 1,
+    BOARD_COUNT
+};
+
+// Scores logged before game times were recorded rank behind timed ties
+const int32_t SCORE_NO_TIME = INT32_MAX;
+
+struct ScoreEntry {
+    int32_t score;
+    int32_t elapsedMs;  // Game time; faster wins equal scores
+    uint32_t timestamp; // Unix time; earlier wins remaining ties
+    std::string name;
+};
+
+class ScoreDatabase {
+public:
+    static ScoreDatabase& Get();
+
+    // Returns the new entry's 1-based rank
+    int Insert(ScoreBoard board, const std::string& name, int score, int elapsedMs = SCORE_NO_TIME);
+
+    // Best-first; at most k entries
+    std::vector<ScoreEntry> TopK(ScoreBoard board, int k);
+    // 1-based rank 'score' would get now (exact ties rank behind existing entries)
+    int RankOf(ScoreBoard board, int score, int elapsedMs = SCORE_NO_TIME);
+    int Count(ScoreBoard board);
+
+private:
+    std::vector<ScoreEntry> boards[BOARD_COUNT]; // Each kept sorted best-first
+    size_t indexedLogBytes = 0; // Log prefix already in scores.idx
+    int tailRecords = 0;        // Log records since the last compaction
+    bool opened = false;
+    bool bulkLoading = false;   // Full rebuild: append, then sort each board once
+
+    void Open();
+    void Place(ScoreBoard board, const ScoreEntry& entry);
+    void ApplyRecord(ByteReader& record);
+    bool LoadIndex();
+    void Compact(size_t logBytes);
+    static bool Better(ScoreBoard board, const ScoreEntry& a, const ScoreEntry& b);
+};
+
+#endif
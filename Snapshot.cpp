@@ -0,0 +1,285 @@
+#include "Snapshot.h"
+#include "js_interop.h"
+#include "RenderWorker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Constants
+const uint32_t SNAPSHOT_MAGIC = 0x50414E53; // "SNAP"
+const size_t SNAPSHOT_HEADER_SIZE = 16;
+const uint32_t SNAPSHOT_MAX_PAYLOAD = 1 << 24; // Sanity limit for corrupted files (score index can reach MBs)
+const uint8_t LOG_RECORD_MARKER = 0xA5;
+const size_t LOG_RECORD_HEADER_SIZE = 7;
+
+#if defined(PLATFORM_WEB)
+const char* SAVE_DIR = "/save/"; // IDBFS mount point (see MountSaveStorage)
+#else
+const char* SAVE_DIR = "";       // Next to the executable's working directory
+#endif
+
+// FNV-1a, cheap enough to run on every autosave
+static uint32_t Checksum(const uint8_t* data, size_t size) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void PutU32(uint8_t* out, uint32_t v) {
+    out[0] = (uint8_t)v; out[1] = (uint8_t)(v >> 8);
+    out[2] = (uint8_t)(v >> 16); out[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t GetU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// --- ByteWriter ---
+void ByteWriter::U16(uint16_t v) {
+    buffer.push_back((uint8_t)v);
+    buffer.push_back((uint8_t)(v >> 8));
+}
+
+void ByteWriter::U32(uint32_t v) {
+    uint8_t tmp[4];
+    PutU32(tmp, v);
+    buffer.insert(buffer.end(), tmp, tmp + 4);
+}
+
+void ByteWriter::F32(float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    U32(bits);
+}
+
+void ByteWriter::F64(double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    U32((uint32_t)bits);
+    U32((uint32_t)(bits >> 32));
+}
+
+void ByteWriter::Bytes(const void* src, size_t count) {
+    const uint8_t* p = (const uint8_t*)src;
+    buffer.insert(buffer.end(), p, p + count);
+}
+
+// --- ByteReader ---
+uint8_t ByteReader::U8() {
+    if (failed || pos + 1 > size) { failed = true; return 0; }
+    return data[pos++];
+}
+
+uint16_t ByteReader::U16() {
+    if (failed || pos + 2 > size) { failed = true; return 0; }
+    uint16_t v = (uint16_t)(data[pos] | (data[pos + 1] << 8));
+    pos += 2;
+    return v;
+}
+
+uint32_t ByteReader::U32() {
+    if (failed || pos + 4 > size) { failed = true; return 0; }
+    uint32_t v = GetU32(data + pos);
+    pos += 4;
+    return v;
+}
+
+float ByteReader::F32() {
+    uint32_t bits = U32();
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return failed ? 0.0f : v;
+}
+
+double ByteReader::F64() {
+    uint64_t lo = U32();
+    uint64_t hi = U32();
+    uint64_t bits = lo | (hi << 32);
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return failed ? 0.0 : v;
+}
+
+bool ByteReader::Bytes(void* out, size_t count) {
+    if (failed || pos + count > size) { failed = true; return false; }
+    memcpy(out, data + pos, count);
+    pos += count;
+    return true;
+}
+
+// --- Storage ---
+// In the worker build FS lives on the page thread, and every fopen/fwrite from the render
+// thread would wait on it. Writes are therefore copied and queued there (PostToPageThread),
+// and reads go through RunOnPageThread, behind whatever writes are still queued. A queued
+// write reports success; if it then fails, the page thread prints why.
+
+// Write to a temp file and rename so a crash mid-write never corrupts the last good save
+static bool WriteFileAtomically(const char* finalPath, const uint8_t* header, size_t headerSize,
+                                const uint8_t* body, size_t bodySize) {
+    char tmpPath[260];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", finalPath);
+
+    FILE* f = fopen(tmpPath, "wb");
+    if (!f) return false;
+    bool ok = fwrite(header, 1, headerSize, f) == headerSize;
+    if (ok && bodySize > 0) ok = fwrite(body, 1, bodySize, f) == bodySize;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) { remove(tmpPath); return false; }
+
+    remove(finalPath); // rename() does not overwrite on every platform
+    return rename(tmpPath, finalPath) == 0;
+}
+
+static bool AppendToFile(const char* path, const uint8_t* header, size_t headerSize,
+                         const uint8_t* body, size_t bodySize) {
+    FILE* f = fopen(path, "ab");
+    if (!f) return false;
+    bool ok = fwrite(header, 1, headerSize, f) == headerSize;
+    if (ok && bodySize > 0) ok = fwrite(body, 1, bodySize, f) == bodySize;
+    return (fclose(f) == 0) && ok;
+}
+
+const char* SnapshotPath(const char* name) {
+    static char path[256];
+    snprintf(path, sizeof(path), "%s%s", SAVE_DIR, name);
+    return path;
+}
+
+bool WriteSnapshotFile(const char* name, SnapshotKind kind, uint16_t version, const ByteWriter& payload) {
+    const std::vector<uint8_t>& body = payload.Data();
+
+    uint8_t header[SNAPSHOT_HEADER_SIZE];
+    PutU32(header, SNAPSHOT_MAGIC);
+    header[4] = (uint8_t)kind; header[5] = (uint8_t)(kind >> 8);
+    header[6] = (uint8_t)version; header[7] = (uint8_t)(version >> 8);
+    PutU32(header + 8, (uint32_t)body.size());
+    PutU32(header + 12, Checksum(body.data(), body.size()));
+
+#if WORKER_RENDERING
+    std::string path = SnapshotPath(name);
+    std::vector<uint8_t> file(header, header + sizeof(header));
+    file.insert(file.end(), body.begin(), body.end());
+    PostToPageThread([path = std::move(path), file = std::move(file)]() {
+        if (!WriteFileAtomically(path.c_str(), file.data(), SNAPSHOT_HEADER_SIZE,
+                                 file.data() + SNAPSHOT_HEADER_SIZE, file.size() - SNAPSHOT_HEADER_SIZE)) {
+            printf("Could not write %s\n", path.c_str());
+        }
+    });
+#else
+    if (!WriteFileAtomically(SnapshotPath(name), header, sizeof(header), body.data(), body.size())) return false;
+#endif
+
+    PersistSaveStorage();
+    return true;
+}
+
+static bool ReadSnapshotFileHere(const char* name, SnapshotKind kind, uint16_t& version, std::vector<uint8_t>& payload) {
+    FILE* f = fopen(SnapshotPath(name), "rb");
+    if (!f) return false;
+
+    uint8_t header[SNAPSHOT_HEADER_SIZE];
+    bool ok = fread(header, 1, sizeof(header), f) == sizeof(header);
+    uint32_t size = ok ? GetU32(header + 8) : 0;
+    ok = ok && GetU32(header) == SNAPSHOT_MAGIC
+            && (uint16_t)(header[4] | (header[5] << 8)) == kind
+            && size <= SNAPSHOT_MAX_PAYLOAD;
+
+    if (ok) {
+        payload.resize(size);
+        ok = size == 0 || fread(payload.data(), 1, size, f) == size;
+        ok = ok && Checksum(payload.data(), size) == GetU32(header + 12);
+    }
+    fclose(f);
+
+    if (!ok) {
+        printf("Snapshot '%s' is corrupt or from another game, ignoring\n", name);
+        return false;
+    }
+    version = (uint16_t)(header[6] | (header[7] << 8));
+    return true;
+}
+
+bool ReadSnapshotFile(const char* name, SnapshotKind kind, uint16_t& version, std::vector<uint8_t>& payload) {
+    bool ok = false;
+    RunOnPageThread([&]() { ok = ReadSnapshotFileHere(name, kind, version, payload); });
+    return ok;
+}
+
+void DeleteSnapshotFile(const char* name) {
+#if WORKER_RENDERING
+    std::string path = SnapshotPath(name);
+    PostToPageThread([path]() { if (remove(path.c_str()) == 0) PersistSaveStorage(); });
+#else
+    if (remove(SnapshotPath(name)) == 0) PersistSaveStorage();
+#endif
+}
+
+// --- Record logs ---
+bool AppendLogRecord(const char* name, const ByteWriter& record) {
+    const std::vector<uint8_t>& body = record.Data();
+    if (body.size() > 0xFFFF) return false;
+
+    uint8_t header[LOG_RECORD_HEADER_SIZE];
+    header[0] = LOG_RECORD_MARKER;
+    header[1] = (uint8_t)body.size(); header[2] = (uint8_t)(body.size() >> 8);
+    PutU32(header + 3, Checksum(body.data(), body.size()));
+
+#if WORKER_RENDERING
+    std::string path = SnapshotPath(name);
+    std::vector<uint8_t> bytes(header, header + sizeof(header));
+    bytes.insert(bytes.end(), body.begin(), body.end());
+    PostToPageThread([path = std::move(path), bytes = std::move(bytes)]() {
+        if (!AppendToFile(path.c_str(), bytes.data(), LOG_RECORD_HEADER_SIZE,
+                          bytes.data() + LOG_RECORD_HEADER_SIZE, bytes.size() - LOG_RECORD_HEADER_SIZE)) {
+            printf("Could not append to %s\n", path.c_str());
+        }
+    });
+    bool ok = true;
+#else
+    bool ok = AppendToFile(SnapshotPath(name), header, sizeof(header), body.data(), body.size());
+#endif
+
+    PersistSaveStorage();
+    return ok;
+}
+
+static bool ReadLogBytes(const char* name, size_t start, size_t* end, std::vector<uint8_t>& data) {
+    FILE* f = fopen(SnapshotPath(name), "rb");
+    if (!f) return false;
+    if (fseek(f, 0, SEEK_END) != 0) { fclose(f); return false; }
+    long total = ftell(f);
+    if (end) *end = total < 0 ? 0 : (size_t)total;
+    if (total < 0 || (size_t)total < start || fseek(f, (long)start, SEEK_SET) != 0) { fclose(f); return false; }
+
+    uint8_t chunk[4096];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + got);
+    fclose(f);
+    return true;
+}
+
+// The file is read on the page thread; the records are visited on the caller's
+bool ReadLogRecords(const char* name, const std::function<void(ByteReader&)>& visit, size_t start, size_t* end) {
+    std::vector<uint8_t> data;
+    bool found = false;
+    RunOnPageThread([&]() { found = ReadLogBytes(name, start, end, data); });
+    if (!found) return false;
+
+    size_t pos = 0, skipped = 0;
+    while (pos + LOG_RECORD_HEADER_SIZE <= data.size()) {
+        const uint8_t* h = data.data() + pos;
+        size_t size = (size_t)(h[1] | (h[2] << 8));
+        bool valid = h[0] == LOG_RECORD_MARKER && pos + LOG_RECORD_HEADER_SIZE + size <= data.size()
+                     && Checksum(h + LOG_RECORD_HEADER_SIZE, size) == GetU32(h + 3);
+        if (!valid) { pos++; skipped++; continue; } // Resync byte by byte
+        ByteReader record(h + LOG_RECORD_HEADER_SIZE, size);
+        visit(record);
+        pos += LOG_RECORD_HEADER_SIZE + size;
+    }
+    if (skipped > 0 || pos != data.size()) printf("Log '%s': skipped %zu corrupt bytes\n", name, skipped + (data.size() - pos));
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// --- Versioned binary snapshots for save/resume ---
+// File layout (little endian):
+//   [magic u32 'SNAP'][kind u16][version u16][payload size u32][checksum u32][payload...]
+// Each game owns its payload layout and bumps its version when the layout changes.
+
+enum SnapshotKind : uint16_t {
+    SNAP_MEMORY = 1,
+    SNAP_SUDOKU = 2,
+    SNAP_RECENT = 3, // Recently played puzzle filter
+    SNAP_SEEDS = 4,  // Verified Killer puzzles waiting to be served
+    SNAP_STATS = 5,  // Player stats summary (sketches + recent games)
+    SNAP_SCORES = 6  // Compacted leaderboard index (desktop score database)
+};
+
+// Appends plain values to a reusable buffer (no per-field allocation once warmed up)
+class ByteWriter {
+public:
+    void Clear() { buffer.clear(); }
+    void U8(uint8_t v) { buffer.push_back(v); }
+    void U16(uint16_t v);
+    void U32(uint32_t v);
+    void I32(int32_t v) { U32((uint32_t)v); }
+    void F32(float v);
+    void F64(double v);
+    void Bytes(const void* data, size_t size);
+
+    const std::vector<uint8_t>& Data() const { return buffer; }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+// Reads values back; any overrun sets a sticky failure flag instead of reading garbage
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data(data), size(size), pos(0), failed(false) {}
+
+    uint8_t U8();
+    uint16_t U16();
+    uint32_t U32();
+    int32_t I32() { return (int32_t)U32(); }
+    float F32();
+    double F64();
+    bool Bytes(void* out, size_t count);
+
+    bool Ok() const { return !failed; }
+    bool AtEnd() const { return pos == size; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool failed;
+};
+
+// Storage (a plain file natively, IDBFS-backed file on the web)
+const char* SnapshotPath(const char* name);
+bool WriteSnapshotFile(const char* name, SnapshotKind kind, uint16_t version, const ByteWriter& payload);
+bool ReadSnapshotFile(const char* name, SnapshotKind kind, uint16_t& version, std::vector<uint8_t>& payload);
+void DeleteSnapshotFile(const char* name);
+
+// --- Append-only record logs ---
+// Each record is [marker u8][size u16][checksum u32][payload]. Appends never touch earlier
+// records; a torn or corrupt record is skipped and reading resyncs on the next valid one.
+bool AppendLogRecord(const char* name, const ByteWriter& record);
+// Visits records from byte offset 'start' on (0 = whole log); 'end' receives the log size
+bool ReadLogRecords(const char* name, const std::function<void(ByteReader&)>& visit,
+                    size_t start = 0, size_t* end = nullptr); // False if missing
+
+#endif
@@ -0,0 +1,36 @@
+#include "SpriteAtlas.h"
+#include <cstdio>
+
+// Constants
+const char* ATLAS_FILE = "atlas.png"; // Natively next to the executable; on the web preloaded into MEMFS
+
+SpriteAtlas& SpriteAtlas::Get() {
+    static SpriteAtlas instance;
+    return instance;
+}
+
+void SpriteAtlas::Load() {
+    if (ATLAS_WIDTH == 0 || !FileExists(ATLAS_FILE)) return; // No art: flat colors
+    texture = LoadTexture(ATLAS_FILE);
+    if (texture.id == 0) return;
+    if (texture.width != ATLAS_WIDTH || texture.height != ATLAS_HEIGHT) {
+        printf("%s is %dx%d, AtlasSprites.h expects %dx%d: rerun pack_atlas.py\n", ATLAS_FILE,
+               texture.width, texture.height, ATLAS_WIDTH, ATLAS_HEIGHT);
+        UnloadTexture(texture);
+        texture = {};
+        return;
+    }
+    // Cards are drawn well below their art size at low render scales (VirtualScreen.h)
+    GenTextureMipmaps(&texture);
+    SetTextureFilter(texture, texture.mipmaps > 1 ? TEXTURE_FILTER_TRILINEAR : TEXTURE_FILTER_BILINEAR);
+}
+
+bool SpriteAtlas::Has(AtlasSprite sprite) const {
+    return texture.id != 0 && ATLAS_RECTS[sprite].width > 0;
+}
+
+bool SpriteAtlas::Draw(AtlasSprite sprite, Rectangle dest, Color tint) const {
+    if (!Has(sprite)) return false;
+    DrawTexturePro(texture, ATLAS_RECTS[sprite], dest, { 0, 0 }, 0.0f, tint);
+    return true;
+}
@@ -0,0 +1,26 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include "raylib.h"
+#include "AtlasSprites.h"
+
+// --- Sprite atlas ---
+// All card and UI artwork is one texture, atlas.png, packed at build time by pack_atlas.py
+// together with AtlasSprites.h (each sprite's rect). Drawing only sprites back to back is a
+// single batch: raylib only flushes when the texture changes. Art is optional: without
+// atlas.png, or for a sprite with no art, Draw returns false and the caller draws shapes.
+
+class SpriteAtlas {
+public:
+    static SpriteAtlas& Get();
+
+    void Load(); // After InitWindow
+    bool Has(AtlasSprite sprite) const;
+    // Stretched over dest; false (nothing drawn) if the sprite is missing
+    bool Draw(AtlasSprite sprite, Rectangle dest, Color tint) const;
+
+private:
+    Texture2D texture = {};
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "StartupTimeline.h"
+#include "GameClock.h"
+#include "GameInput.h"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+
+#if defined(PLATFORM_WEB)
+#include <emscripten.h>
+#include "InteropMessages.h"
+#endif
+
+// Constants
+struct StartupPhaseInfo {
+    const char* label;
+    bool webOnly; // Marked by the page; no native equivalent
+};
+
+const StartupPhaseInfo STARTUP_PHASES[STARTUP_COUNT] = {
+    { "index.js running", true },
+    { "index.wasm first byte", true },
+    { "index.wasm compiled", true },
+    { "index.wasm downloaded", true },
+    { "index.wasm instantiated", true },
+    { "main()", false },
+    { "InitWindow", false },
+    { "Saves loaded", false },
+    { "First frame", false },
+    { "Interactive", false },
+    { "Leaderboard shown", true },
+    { "Memory code ready", false },
+    { "Killer Sudoku code ready", false },
+};
+
+#if defined(PLATFORM_WEB)
+const char* STARTUP_ORIGIN = "page start";
+#else
+const char* STARTUP_ORIGIN = "process start";
+// Static initialization, before main() and anything it loads
+static const double processStartMs = MonotonicMs();
+#endif
+
+StartupTimeline& StartupTimeline::Get() {
+    static StartupTimeline instance;
+    return instance;
+}
+
+StartupTimeline::StartupTimeline() {
+#if defined(PLATFORM_WEB)
+    // The page's performance.now() counts from navigation start, and so do the page's own marks;
+    // MonotonicMs() only matches it in single-threaded builds
+    origin = PageClockOffsetMs();
+#else
+    origin = processStartMs;
+#endif
+    for (int i = 0; i < STARTUP_COUNT; i++) marks[i] = -1.0;
+}
+
+void StartupTimeline::Mark(StartupPhase phase) {
+    if (marks[phase] >= 0) return;
+    marks[phase] = MonotonicMs() - origin;
+#if defined(PLATFORM_WEB)
+    MsgStartupMark message = { (uint8_t)phase, marks[phase] };
+    SendInteropMessage(message);
+#endif
+}
+
+// The page's marks (Module.startupMarks, indexed by phase). Only when a report is built:
+// in the worker build this waits for the page thread.
+void StartupTimeline::PullPageMarks() {
+#if defined(PLATFORM_WEB)
+    for (int i = 0; i < STARTUP_COUNT; i++) {
+        if (marks[i] >= 0) continue;
+        marks[i] = MAIN_THREAD_EM_ASM_DOUBLE({
+            const m = Module.startupMarks;
+            return (m && m[$0] !== undefined) ? m[$0] : -1;
+        }, i);
+    }
+#endif
+}
+
+void StartupTimeline::AfterPresent(bool savesReady) {
+    Mark(STARTUP_FIRST_FRAME);
+    if (marks[STARTUP_INTERACTIVE] >= 0 || !savesReady) return;
+    Mark(STARTUP_INTERACTIVE);
+    printf("%s", FormatReport().c_str());
+}
+
+// Reached phases in time order, then the ones still pending
+static void OrderPhases(const double* marks, int* order, int& reached, int& total) {
+    total = 0;
+    for (int i = 0; i < STARTUP_COUNT; i++) {
+#if !defined(PLATFORM_WEB)
+        if (STARTUP_PHASES[i].webOnly) continue;
+#endif
+        order[total++] = i;
+    }
+    std::stable_sort(order, order + total, [marks](int a, int b) {
+        if ((marks[a] < 0) != (marks[b] < 0)) return marks[b] < 0;
+        return marks[a] < marks[b];
+    });
+    reached = 0;
+    while (reached < total && marks[order[reached]] >= 0) reached++;
+}
+
+std::string StartupTimeline::FormatReport() {
+    PullPageMarks();
+    int order[STARTUP_COUNT], reached, total;
+    OrderPhases(marks, order, reached, total);
+
+    std::string text;
+    char line[128];
+    if (marks[STARTUP_INTERACTIVE] >= 0) {
+        snprintf(line, sizeof(line), "Startup: interactive at %.0f ms (ms since %s)\n", marks[STARTUP_INTERACTIVE], STARTUP_ORIGIN);
+    } else {
+        snprintf(line, sizeof(line), "Startup: not interactive yet (ms since %s)\n", STARTUP_ORIGIN);
+    }
+    text += line;
+    double previous = 0.0;
+    for (int i = 0; i < reached; i++) {
+        double ms = marks[order[i]];
+        snprintf(line, sizeof(line), "  %-26s %9.1f  +%.1f\n", STARTUP_PHASES[order[i]].label, ms, ms - previous);
+        text += line;
+        previous = ms;
+    }
+    if (reached < total) {
+        text += "  Pending:";
+        for (int i = reached; i < total; i++) {
+            text += std::string(i > reached ? ", " : " ") + STARTUP_PHASES[order[i]].label;
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+// --- Overlay ---
+void StartupTimeline::Update() {
+    if (!InputKeyPressed(KEY_F2)) return;
+    overlayVisible = !overlayVisible;
+    if (overlayVisible) PullPageMarks(); // The leaderboard and game code usually land after startup
+}
+
+// A waterfall: each phase's bar runs from the phase before it
+void StartupTimeline::DrawOverlay() {
+    if (!overlayVisible) return;
+    int order[STARTUP_COUNT], reached, total;
+    OrderPhases(marks, order, reached, total);
+
+    const int x = 20, y = 40, width = 760, height = 80 + total * 24;
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.85f));
+    DrawText(marks[STARTUP_INTERACTIVE] >= 0
+                 ? TextFormat("STARTUP  (interactive at %.0f ms)", marks[STARTUP_INTERACTIVE])
+                 : "STARTUP  (not interactive yet)", x + 15, y + 12, 20, GOLD);
+    DrawText(TextFormat("F2 close   ms since %s", STARTUP_ORIGIN), x + 15, y + 38, 14, LIGHTGRAY);
+
+    const int barX = x + 250, barWidth = 380;
+    double end = (reached > 0) ? marks[order[reached - 1]] : 1.0;
+    if (end <= 0.0) end = 1.0;
+    double previous = 0.0;
+    int line = y + 66;
+    for (int i = 0; i < total; i++, line += 24) {
+        int phase = order[i];
+        bool isReached = i < reached;
+        Color color = (phase == STARTUP_INTERACTIVE) ? GOLD : (STARTUP_PHASES[phase].webOnly ? SKYBLUE : LIME);
+        DrawText(STARTUP_PHASES[phase].label, x + 15, line, 16, isReached ? RAYWHITE : GRAY);
+        if (!isReached) {
+            DrawText("pending", barX + barWidth + 10, line, 16, GRAY);
+            continue;
+        }
+        double ms = marks[phase];
+        int from = (int)(previous / end * barWidth), to = (int)(ms / end * barWidth);
+        DrawRectangle(barX + from, line + 2, std::max(to - from, 1), 12, color);
+        DrawText(TextFormat("%.0f ms", ms), barX + barWidth + 10, line, 16, LIGHTGRAY);
+        previous = ms;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef STARTUP_TIMELINE_H
+#define STARTUP_TIMELINE_H
+
+#include <string>
+
+// --- Startup timeline ---
+// When each step between opening the page and a usable menu happened, in ms since the page
+// started loading (the page's performance.now(); MonotonicMs() shifted by PageClockOffsetMs) or natively
+// since the process started. The page marks what happens outside the game: the index.wasm
+// download, compile and instantiate (minshell.html times them through Module.instantiateWasm),
+// the save storage load and the first leaderboard render. The game marks the rest and sends
+// them to the page (StartupMark messages), which keeps every mark in Module.startupMarks and
+// passes them to window.onStartupReport if the page defines it.
+// Time to interactive is the first frame presented with the saves loaded (resuming a game and
+// the stats screen need them). The report is printed then, shown by F2 and added to the F4 export.
+
+enum StartupPhase {
+    STARTUP_SCRIPT,            // index.js running (page)
+    STARTUP_WASM_RESPONSE,     // First byte of index.wasm (page)
+    STARTUP_WASM_COMPILED,     // Streaming compile done, usually with the last byte (page)
+    STARTUP_WASM_FETCHED,      // Last byte of index.wasm (page, Resource Timing)
+    STARTUP_WASM_INSTANTIATED, // (page)
+    STARTUP_MAIN,              // main() entered
+    STARTUP_WINDOW,            // InitWindow returned
+    STARTUP_STORAGE,           // Saves loaded (page: IDBFS; natively nothing to load)
+    STARTUP_FIRST_FRAME,       // First UpdateDrawFrame presented
+    STARTUP_INTERACTIVE,       // Time to interactive
+    STARTUP_LEADERBOARD,       // First leaderboard render (page)
+    STARTUP_MEMORY_CODE,       // Game code ready (split build: side module fetched and linked);
+    STARTUP_SUDOKU_CODE,       //   otherwise the first time the menu asks for it
+    STARTUP_COUNT
+};
+
+class StartupTimeline {
+public:
+    static StartupTimeline& Get();
+
+    // Records the phase as reached now; later calls for the same phase are ignored
+    void Mark(StartupPhase phase);
+    // Right after each EndDrawing
+    void AfterPresent(bool savesReady);
+
+    double PhaseMs(StartupPhase phase) const { return marks[phase]; } // -1 if not reached (yet)
+
+    std::string FormatReport();
+
+    // Overlay (F2)
+    void Update();
+    void DrawOverlay();
+
+private:
+    StartupTimeline();
+
+    double origin;              // MonotonicMs() of "0 ms"
+    double marks[STARTUP_COUNT];
+    bool overlayVisible = false;
+
+    void PullPageMarks();
+};
+
+#endif
@@ -0,0 +1,381 @@
+// --- Static file server ---
+// Serves the packed web build (pack_assets.py), in development and as the production origin:
+//
+//   static_server [dir (dist)] [port (8080)]
+//
+// A standalone native tool, not part of the game: POSIX sockets, one thread per connection,
+// file bodies handed to the kernel with sendfile (no copy through user space). Per request:
+//   - the precompressed .br/.gz sibling the client accepts, else the file itself
+//   - Content-Type by extension; application/wasm lets the browser compile while downloading
+//   - content-hashed names (index.1a2b3c4d5e.wasm) cached as immutable for a year, anything
+//     else (index.html) revalidated every load against its ETag, so repeat visits cost one 304
+//   - COOP/COEP on every response: the threaded and worker builds need cross-origin isolation
+// GET and HEAD only, no ranges, no directory listings.
+
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <strings.h>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#define SEND_MORE MSG_MORE // Headers wait for the body's first packet
+#else
+#define SEND_MORE 0
+#endif
+
+// Constants
+const char* DEFAULT_ROOT = "dist";
+const int DEFAULT_PORT = 8080;
+const int LISTEN_BACKLOG = 64;
+const size_t MAX_REQUEST_HEAD = 8192;
+const int IDLE_TIMEOUT_SEC = 15;       // Keep-alive connections with nothing to say
+const size_t MIN_CONTENT_HASH = 8;     // Hex digits in name.<hash>.ext (pack_assets.py writes 10)
+const char* IMMUTABLE_CACHE = "public, max-age=31536000, immutable";
+const char* REVALIDATE_CACHE = "no-cache";
+
+struct ContentType {
+    const char* extension;
+    const char* type;
+};
+
+const ContentType CONTENT_TYPES[] = {
+    { ".html", "text/html; charset=utf-8" },
+    { ".js",   "text/javascript; charset=utf-8" },
+    { ".wasm", "application/wasm" },
+    { ".css",  "text/css; charset=utf-8" },
+    { ".json", "application/json" },
+    { ".txt",  "text/plain; charset=utf-8" },
+    { ".png",  "image/png" },
+    { ".ico",  "image/x-icon" },
+    { ".data", "application/octet-stream" },
+};
+
+// Tried in order of preference
+struct Encoding {
+    const char* token;  // In Accept-Encoding / Content-Encoding
+    const char* suffix; // Of the precompressed file
+};
+
+const Encoding ENCODINGS[] = {
+    { "br",   ".br" },
+    { "gzip", ".gz" },
+};
+
+struct Request {
+    std::string method;
+    std::string path;
+    std::string acceptEncoding;
+    std::string ifNoneMatch;
+    bool keepAlive = true;
+};
+
+static const char* FindContentType(const std::string& path) {
+    for (const ContentType& c : CONTENT_TYPES) {
+        size_t n = strlen(c.extension);
+        if (path.size() >= n && path.compare(path.size() - n, n, c.extension) == 0) return c.type;
+    }
+    return "application/octet-stream";
+}
+
+// name.<hex>.ext: pack_assets.py never writes different bytes under the same name
+static bool IsContentHashed(const std::string& path) {
+    size_t slash = path.rfind('/');
+    std::string name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    size_t last = name.rfind('.');
+    if (last == std::string::npos || last == 0) return false;
+    size_t first = name.rfind('.', last - 1);
+    if (first == std::string::npos || last - first - 1 < MIN_CONTENT_HASH) return false;
+    for (size_t i = first + 1; i < last; i++) {
+        if (!isxdigit((unsigned char)name[i])) return false;
+    }
+    return true;
+}
+
+static std::string Trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string::npos) return "";
+    return s.substr(begin, s.find_last_not_of(" \t") - begin + 1);
+}
+
+static bool EqualsNoCase(const std::string& a, const char* b) {
+    return strcasecmp(a.c_str(), b) == 0;
+}
+
+// "gzip, deflate, br;q=0.8": listed without q=0
+static bool Accepts(const std::string& acceptEncoding, const char* token) {
+    size_t start = 0;
+    while (start <= acceptEncoding.size()) {
+        size_t end = acceptEncoding.find(',', start);
+        if (end == std::string::npos) end = acceptEncoding.size();
+        std::string item = acceptEncoding.substr(start, end - start);
+        size_t semicolon = item.find(';');
+        if (EqualsNoCase(Trim(item.substr(0, semicolon)), token)) {
+            if (semicolon == std::string::npos) return true;
+            std::string params = Trim(item.substr(semicolon + 1));
+            return !(params.compare(0, 2, "q=") == 0 && atof(params.c_str() + 2) <= 0.0);
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+// Only plain names below the root: no "..", no hidden files, nothing escaped
+static bool IsSafePath(const std::string& path) {
+    if (path.empty() || path[0] != '/') return false;
+    if (path.find("/.") != std::string::npos) return false;
+    for (char c : path) {
+        if (c == '\\' || c == '%' || (unsigned char)c < 0x20) return false;
+    }
+    return true;
+}
+
+static bool ParseRequest(const std::string& head, Request& req) {
+    size_t lineEnd = head.find("\r\n");
+    std::string requestLine = head.substr(0, lineEnd);
+    size_t sp1 = requestLine.find(' ');
+    size_t sp2 = requestLine.rfind(' ');
+    if (sp1 == std::string::npos || sp2 == sp1) return false;
+    req.method = requestLine.substr(0, sp1);
+    req.path = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+    req.path = req.path.substr(0, req.path.find_first_of("?#"));
+    std::string version = requestLine.substr(sp2 + 1);
+    if (version.compare(0, 5, "HTTP/") != 0) return false;
+    req.keepAlive = (version == "HTTP/1.1");
+
+    size_t pos = lineEnd + 2;
+    while (pos < head.size()) {
+        size_t end = head.find("\r\n", pos);
+        if (end == std::string::npos) end = head.size();
+        std::string line = head.substr(pos, end - pos);
+        pos = end + 2;
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon);
+        std::string value = Trim(line.substr(colon + 1));
+        if (EqualsNoCase(name, "Accept-Encoding")) req.acceptEncoding = value;
+        else if (EqualsNoCase(name, "If-None-Match")) req.ifNoneMatch = value;
+        else if (EqualsNoCase(name, "Connection")) {
+            if (EqualsNoCase(value, "close")) req.keepAlive = false;
+            else if (EqualsNoCase(value, "keep-alive")) req.keepAlive = true;
+        }
+    }
+    return true;
+}
+
+// One request head; bytes past it (a pipelined request) stay in pending. False on close,
+// timeout or an oversized head.
+static bool ReadRequest(int sock, std::string& pending, std::string& head) {
+    for (;;) {
+        size_t end = pending.find("\r\n\r\n");
+        if (end != std::string::npos) {
+            head = pending.substr(0, end);
+            pending.erase(0, end + 4);
+            return true;
+        }
+        if (pending.size() > MAX_REQUEST_HEAD) return false;
+        char buffer[2048];
+        ssize_t n = recv(sock, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        pending.append(buffer, (size_t)n);
+    }
+}
+
+static bool SendAll(int sock, const char* data, size_t size, int flags) {
+    while (size > 0) {
+        ssize_t n = send(sock, data, size, flags | MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool SendFileBody(int sock, int file, off_t size) {
+    off_t offset = 0;
+#if defined(__linux__)
+    while (offset < size) {
+        ssize_t n = sendfile(sock, file, &offset, (size_t)(size - offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+    }
+#else
+    char buffer[64 * 1024];
+    while (offset < size) {
+        ssize_t n = pread(file, buffer, sizeof(buffer), offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0 || !SendAll(sock, buffer, (size_t)n, 0)) return false;
+        offset += n;
+    }
+#endif
+    return true;
+}
+
+static std::string HttpDate() {
+    char text[64];
+    time_t now = time(nullptr);
+    struct tm utc;
+    gmtime_r(&now, &utc);
+    strftime(text, sizeof(text), "%a, %d %b %Y %H:%M:%S GMT", &utc);
+    return text;
+}
+
+// Status line plus what every response carries
+static std::string ResponseHead(int status, const char* reason, bool keepAlive) {
+    char line[64];
+    snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n", status, reason);
+    std::string head = line;
+    head += "Date: " + HttpDate() + "\r\n";
+    head += "Server: static_server\r\n";
+    head += "Cross-Origin-Opener-Policy: same-origin\r\n";
+    head += "Cross-Origin-Embedder-Policy: require-corp\r\n";
+    head += "Cross-Origin-Resource-Policy: same-origin\r\n";
+    head += "X-Content-Type-Options: nosniff\r\n";
+    head += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    return head;
+}
+
+static bool SendError(int sock, int status, const char* reason, bool keepAlive, bool withBody) {
+    std::string body = std::string(reason) + "\n";
+    std::string head = ResponseHead(status, reason, keepAlive);
+    head += "Content-Type: text/plain; charset=utf-8\r\n";
+    head += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+    if (withBody) head += body;
+    return SendAll(sock, head.data(), head.size(), 0);
+}
+
+// False if the connection has to close
+static bool Serve(int sock, const std::string& root, const Request& req) {
+    bool isHead = (req.method == "HEAD");
+    if (req.method != "GET" && !isHead) {
+        printf("%s %s 405\n", req.method.c_str(), req.path.c_str());
+        return SendError(sock, 405, "Method Not Allowed", req.keepAlive, true) && req.keepAlive;
+    }
+    std::string path = req.path;
+    if (!path.empty() && path.back() == '/') path += "index.html";
+    struct stat original;
+    std::string file = root + path;
+    if (!IsSafePath(path) || stat(file.c_str(), &original) != 0 || !S_ISREG(original.st_mode)) {
+        printf("%s %s 404\n", req.method.c_str(), req.path.c_str());
+        return SendError(sock, 404, "Not Found", req.keepAlive, !isHead) && req.keepAlive;
+    }
+
+    // A variant older than its file is left over from a previous build
+    const Encoding* encoding = nullptr;
+    bool hasVariants = false;
+    struct stat served = original;
+    for (const Encoding& e : ENCODINGS) {
+        struct stat variant;
+        if (stat((file + e.suffix).c_str(), &variant) != 0 || variant.st_mtime < original.st_mtime) continue;
+        hasVariants = true;
+        if (!encoding && Accepts(req.acceptEncoding, e.token)) {
+            encoding = &e;
+            served = variant;
+        }
+    }
+    if (encoding) file += encoding->suffix;
+
+    char etag[64];
+    snprintf(etag, sizeof(etag), "\"%llx-%llx%s%s\"", (unsigned long long)served.st_size,
+             (unsigned long long)served.st_mtime, encoding ? "-" : "", encoding ? encoding->token : "");
+    bool notModified = !req.ifNoneMatch.empty() &&
+        (req.ifNoneMatch == "*" || req.ifNoneMatch.find(etag) != std::string::npos);
+
+    std::string head = notModified ? ResponseHead(304, "Not Modified", req.keepAlive)
+                                   : ResponseHead(200, "OK", req.keepAlive);
+    head += std::string("Cache-Control: ") + (IsContentHashed(path) ? IMMUTABLE_CACHE : REVALIDATE_CACHE) + "\r\n";
+    head += std::string("ETag: ") + etag + "\r\n";
+    if (hasVariants) head += "Vary: Accept-Encoding\r\n";
+    if (!notModified) {
+        head += std::string("Content-Type: ") + FindContentType(path) + "\r\n";
+        if (encoding) head += std::string("Content-Encoding: ") + encoding->token + "\r\n";
+        head += "Content-Length: " + std::to_string((long long)served.st_size) + "\r\n";
+    }
+    head += "\r\n";
+
+    printf("%s %s %d %s %lld\n", req.method.c_str(), req.path.c_str(), notModified ? 304 : 200,
+           encoding ? encoding->token : "identity", notModified ? 0LL : (long long)served.st_size);
+    bool sendBody = !notModified && !isHead && served.st_size > 0;
+    if (!sendBody) return SendAll(sock, head.data(), head.size(), 0) && req.keepAlive;
+
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SendError(sock, 404, "Not Found", false, true);
+        return false;
+    }
+    bool sent = SendAll(sock, head.data(), head.size(), SEND_MORE) && SendFileBody(sock, fd, served.st_size);
+    close(fd);
+    return sent && req.keepAlive;
+}
+
+static void HandleConnection(int sock, std::string root) {
+    struct timeval timeout = { IDLE_TIMEOUT_SEC, 0 };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int noDelay = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    std::string pending, head;
+    while (ReadRequest(sock, pending, head)) {
+        Request req;
+        if (!ParseRequest(head, req)) {
+            SendError(sock, 400, "Bad Request", false, true);
+            break;
+        }
+        if (!Serve(sock, root, req)) break;
+    }
+    close(sock);
+}
+
+int main(int argc, char** argv) {
+    std::string root = (argc > 1) ? argv[1] : DEFAULT_ROOT;
+    int port = (argc > 2) ? atoi(argv[2]) : DEFAULT_PORT;
+    while (root.size() > 1 && root.back() == '/') root.pop_back();
+
+    struct stat rootInfo;
+    if (stat(root.c_str(), &rootInfo) != 0 || !S_ISDIR(rootInfo.st_mode)) {
+        printf("%s is not a directory (run pack_assets.py first?)\n", root.c_str());
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    setvbuf(stdout, nullptr, _IOLBF, 0); // Request log, also when piped
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listener, LISTEN_BACKLOG) != 0) {
+        printf("Could not listen on port %d: %s\n", port, strerror(errno));
+        return 1;
+    }
+    printf("Serving %s on http://localhost:%d/\n", root.c_str(), port);
+
+    for (;;) {
+        int sock = accept(listener, nullptr, nullptr);
+        if (sock < 0) {
+            if (errno != EINTR) printf("accept: %s\n", strerror(errno));
+            continue;
+        }
+        std::thread(HandleConnection, sock, root).detach();
+    }
+}
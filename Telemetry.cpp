@@ -0,0 +1,82 @@
+#include "Telemetry.h"
+#include <cstdio>
+#include <ctime>
+
+#if defined(PLATFORM_WEB)
+#include "InteropMessages.h"
+#endif
+
+// Constants
+const char* TELEMETRY_LOG_FILE = "telemetry.log";
+const uint8_t TELEMETRY_BATCH_VERSION = 1;
+const int TELEMETRY_BATCH_EVENTS = 512;      // Native: events per file write (4 KB)
+const uint32_t TELEMETRY_WRITE_INTERVAL_MS = 10000; // ...or at least this often while events trickle in
+
+Telemetry& Telemetry::Get() {
+    static Telemetry instance;
+    return instance;
+}
+
+Telemetry::Telemetry() : head(0), tail(0), dropped(0) {
+    epoch = std::chrono::steady_clock::now();
+    sessionId = (uint32_t)time(nullptr);
+    frameMs = 0;
+    batchEvents = 0;
+    lastWriteMs = 0;
+}
+
+void Telemetry::Record(TelemetryEvent event, int arg, int value) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= RING_SIZE) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    TelemetryRecord& slot = ring[h & (RING_SIZE - 1)];
+    slot.event = event;
+    slot.arg = (uint8_t)arg;
+    slot.value = (uint16_t)(value < 0 ? 0 : (value > 0xFFFF ? 0xFFFF : value));
+    slot.timeMs = frameMs;
+    head.store(h + 1, std::memory_order_release);
+}
+
+void Telemetry::Flush(bool force) {
+    uint32_t h = head.load(std::memory_order_acquire);
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    for (; t != h; t++) {
+        const TelemetryRecord& r = ring[t & (RING_SIZE - 1)];
+#if defined(PLATFORM_WEB)
+        MsgTelemetryEvent message = { r.event, r.arg, r.value, r.timeMs };
+        SendInteropMessage(message);
+#else
+        if (batchEvents == 0) {
+            batch.Clear();
+            batch.U8(TELEMETRY_BATCH_VERSION);
+            batch.U32(sessionId);
+        }
+        batch.U8(r.event);
+        batch.U8(r.arg);
+        batch.U16(r.value);
+        batch.U32(r.timeMs);
+        batchEvents++;
+#endif
+    }
+    tail.store(t, std::memory_order_release);
+
+    // The next frame's events happen after this point
+    frameMs = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+
+#if !defined(PLATFORM_WEB)
+    if (batchEvents == 0) return;
+    if (force || batchEvents >= TELEMETRY_BATCH_EVENTS || frameMs - lastWriteMs >= TELEMETRY_WRITE_INTERVAL_MS) {
+        WriteBatch();
+        lastWriteMs = frameMs;
+    }
+#endif
+}
+
+// Batch record: version, session id, then 8-byte events until the end of the record
+void Telemetry::WriteBatch() {
+    if (!AppendLogRecord(TELEMETRY_LOG_FILE, batch)) printf("Could not write %s\n", TELEMETRY_LOG_FILE);
+    batchEvents = 0;
+}
@@ -0,0 +1,71 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "Snapshot.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// --- Gameplay telemetry ---
+// Games call Record() at the moment something happens; it only stores 8 bytes in a
+// lock-free ring. Input is polled once per frame, so events carry the frame's timestamp
+// (taken in Flush) rather than reading the clock per event. Flush() runs once at the end of the frame (after
+// EndDrawing) and moves the batch out: natively to "telemetry.log" (one checksummed log
+// record per batch), on the web to the page through the interop channel
+// (Module.interopHandlers.TelemetryEvent -> window.onTelemetry, if the page defines it).
+// Single producer: events are recorded from the game thread only.
+
+enum TelemetryEvent : uint8_t {
+    TELE_MEMORY_START = 1, // arg = difficulty, value = cards
+    TELE_CARD_FLIP,        // value = grid index
+    TELE_CARD_MATCH,       // value = grid index of the first card
+    TELE_MEMORY_ERROR,     // Mismatch although the partner card had been seen; value = grid index
+    TELE_MEMORY_WIN,       // value = score
+    TELE_MEMORY_QUIT,      // value = pairs found
+    TELE_SUDOKU_START,     // arg = difficulty
+    TELE_DIGIT_ENTRY,      // arg = digit (0 = erased), value = cell
+    TELE_CONFLICT,         // Entered digit is wrong; arg = digit, value = cell
+    TELE_SUDOKU_WIN,       // value = score
+    TELE_SUDOKU_QUIT       // value = seconds played
+};
+
+// Binary layout, little-endian: event, arg, value (u16), ms since the session started (u32)
+struct TelemetryRecord {
+    uint8_t event;
+    uint8_t arg;
+    uint16_t value;
+    uint32_t timeMs;
+};
+
+class Telemetry {
+public:
+    static const uint32_t RING_SIZE = 4096; // Power of two; far more than one frame's events
+
+    static Telemetry& Get();
+
+    // Hot path: one slot write, no clock read. Drops (and counts) if the ring is full.
+    void Record(TelemetryEvent event, int arg = 0, int value = 0);
+
+    // End of frame only. 'force' writes the native batch now (shutdown).
+    void Flush(bool force = false);
+
+    uint32_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    Telemetry();
+
+    TelemetryRecord ring[RING_SIZE];
+    std::atomic<uint32_t> head; // Written by Record
+    std::atomic<uint32_t> tail; // Written by Flush
+    std::atomic<uint32_t> dropped;
+    std::chrono::steady_clock::time_point epoch;
+    uint32_t frameMs;     // Stamp for events recorded this frame
+    uint32_t sessionId;   // Unix time at startup, groups batches in the log
+    ByteWriter batch;     // Native: events waiting for the next file write
+    int batchEvents;
+    uint32_t lastWriteMs;
+
+    void WriteBatch();
+};
+
+#endif
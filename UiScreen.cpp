@@ -0,0 +1,75 @@
+#include "UiScreen.h"
+#include "GameInput.h"
+#include "SpriteAtlas.h"
+
+// Constants
+const float ICON_PADDING = 4.0f; // Around the icon, inside the button
+
+int UiScreen::AddButton(Rectangle rect, const char* label, const UiStyle& style) {
+    Button button = { rect, label, style, { 0, 0 }, 0, SPRITE_COUNT, true, false, false };
+    Measure(button);
+    buttons.push_back(button);
+    return (int)buttons.size() - 1;
+}
+
+void UiScreen::SetLabel(int id, const char* label) {
+    if (buttons[id].label == label) return;
+    buttons[id].label = label;
+    Measure(buttons[id]);
+}
+
+void UiScreen::SetEnabled(int id, bool enabled) {
+    buttons[id].enabled = enabled;
+}
+
+void UiScreen::Measure(Button& button) {
+    button.labelWidth = (float)MeasureText(button.label, button.style.fontSize);
+    button.textPosition.x = button.rect.x + (button.rect.width - button.labelWidth) / 2;
+    button.textPosition.y = button.rect.y + (button.rect.height - button.style.fontSize) / 2;
+}
+
+int UiScreen::ButtonAt(Vector2 point) const {
+    for (size_t i = 0; i < buttons.size(); i++) {
+        if (CheckCollisionPointRec(point, buttons[i].rect)) return (int)i;
+    }
+    return -1;
+}
+
+void UiScreen::Update() {
+    for (auto& button : buttons) button.hovered = button.clicked = false;
+
+    pressCount = InputPressCount() < MAX_PRESSES ? InputPressCount() : MAX_PRESSES;
+    for (int p = 0; p < pressCount; p++) {
+        pressTargets[p] = ButtonAt(InputPress(p));
+        if (pressTargets[p] >= 0 && buttons[pressTargets[p]].enabled) buttons[pressTargets[p]].clicked = true;
+    }
+
+    // Lit under the mouse, and under each finger for as long as it is down
+    int over = ButtonAt(InputPointer());
+    if (over >= 0) buttons[over].hovered = true;
+    for (int t = 0; t < InputTouchCount(); t++) {
+        if (InputTouch(t).released) continue;
+        over = ButtonAt(InputTouch(t).position);
+        if (over >= 0) buttons[over].hovered = true;
+    }
+}
+
+void UiScreen::Draw() const {
+    for (const auto& button : buttons) {
+        const UiStyle& style = button.style;
+        bool lit = button.enabled && button.hovered;
+        DrawRectangleRec(button.rect, lit ? style.hover : style.fill);
+        DrawRectangleLinesEx(button.rect, style.borderWidth, style.border);
+        Color text = button.enabled ? style.text : GRAY;
+
+        Vector2 textPosition = button.textPosition;
+        if (button.icon != SPRITE_COUNT && SpriteAtlas::Get().Has(button.icon)) {
+            // Icon and label centered together
+            float side = button.rect.height - 2 * ICON_PADDING;
+            float left = button.rect.x + (button.rect.width - side - ICON_PADDING - button.labelWidth) / 2;
+            SpriteAtlas::Get().Draw(button.icon, { left, button.rect.y + ICON_PADDING, side, side }, text);
+            textPosition.x = left + side + ICON_PADDING;
+        }
+        DrawText(button.label, (int)textPosition.x, (int)textPosition.y, style.fontSize, text);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef UI_SCREEN_H
+#define UI_SCREEN_H
+
+#include "raylib.h"
+#include "AtlasSprites.h"
+#include <vector>
+
+// --- UI screens ---
+// A screen's buttons are declared once, when it is first shown, and keep their rectangles;
+// a label's text position is measured only when the label changes. Each frame:
+//   Update() - one hit-test pass: which button is under the pointer (or a finger), and which
+//              one each of this frame's presses (GameInput.h) landed on
+//   then the screen reacts to Clicked()/PressTarget(), and finally
+//   Draw()   - every button, lit as Update found it
+// Input and drawing read the same rectangles, so a hitbox can't drift from what is drawn.
+
+struct UiStyle {
+    Color fill;
+    Color hover;   // Fill under the pointer
+    Color border;
+    Color text;
+    float borderWidth;
+    int fontSize;
+};
+
+const UiStyle UI_MENU_BUTTON = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKGRAY, 2, 24 };
+const UiStyle UI_BACK_BUTTON = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKGRAY, 1, 10 };
+
+class UiScreen {
+public:
+    static const int MAX_PRESSES = 16; // Per frame; more are not hit-tested
+
+    bool IsBuilt() const { return !buttons.empty(); }
+    int AddButton(Rectangle rect, const char* label, const UiStyle& style); // Returns the button's id
+
+    // Labels are kept by pointer (string literals, or text that outlives the screen)
+    void SetLabel(int id, const char* label);
+    void SetEnabled(int id, bool enabled); // Disabled: drawn grayed, never clicked
+    // Drawn left of the label when the atlas has the art (SpriteAtlas::Has); text only otherwise
+    void SetIcon(int id, AtlasSprite icon) { buttons[id].icon = icon; }
+
+    void Update();
+    bool Clicked(int id) const { return buttons[id].clicked; }
+    bool Hovered(int id) const { return buttons[id].hovered; }
+    // Button that the frame's press 'index' (InputPress) landed on, -1 if none; disabled ones count
+    int PressTarget(int index) const { return index < pressCount ? pressTargets[index] : -1; }
+
+    void Draw() const;
+
+private:
+    struct Button {
+        Rectangle rect;
+        const char* label;
+        UiStyle style;
+        Vector2 textPosition; // Centered; measured when the label changes
+        float labelWidth;
+        AtlasSprite icon;     // SPRITE_COUNT: none
+        bool enabled;
+        bool hovered;
+        bool clicked;
+    };
+
+    std::vector<Button> buttons;
+    int pressTargets[MAX_PRESSES];
+    int pressCount = 0;
+
+    int ButtonAt(Vector2 point) const;
+    void Measure(Button& button);
+};
+
+#endif
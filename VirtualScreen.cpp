@@ -0,0 +1,134 @@
+#include "VirtualScreen.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cstdio>
+#include <chrono>
+
+#if defined(PLATFORM_WEB)
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#endif
+
+// Constants
+const float VirtualScreen::QUALITY_SCALES[RESOLUTION_LEVELS] = { 1.0f, 0.85f, 0.7f, 0.6f, 0.5f };
+const int GPU_SAMPLE_INTERVAL = 30; // Frames between waits for the GPU; each one stalls its frame
+#if defined(PLATFORM_WEB)
+const char* CANVAS_SELECTOR = "#canvas";
+const int MAX_CANVAS_SIZE = 4096;              // Per side; WebGL's guaranteed renderbuffer size
+#endif
+
+VirtualScreen& VirtualScreen::Get() {
+    static VirtualScreen instance;
+    return instance;
+}
+
+#if defined(PLATFORM_WEB)
+// Also fires when the page zoom, and so devicePixelRatio, changes
+static EM_BOOL OnCanvasResize(int, const EmscriptenUiEvent*, void*) {
+    VirtualScreen::Get().CanvasResized();
+    return 0;
+}
+#endif
+
+void VirtualScreen::Init() {
+#if defined(PLATFORM_WEB)
+    // In the worker build this queues the event to the render thread
+    emscripten_set_resize_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, 0, OnCanvasResize,
+                                             EM_CALLBACK_THREAD_CONTEXT_CALLING_THREAD);
+#else
+    SetWindowState(FLAG_WINDOW_RESIZABLE);
+    SetWindowMinSize(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+#endif
+}
+
+#if defined(PLATFORM_WEB)
+// The page styles the canvas's size (minshell.html); its backing store follows in device pixels
+void VirtualScreen::FitCanvas() {
+    canvasDirty = false;
+    if (emscripten_get_element_css_size(CANVAS_SELECTOR, &cssWidth, &cssHeight) != EMSCRIPTEN_RESULT_SUCCESS) return;
+    double ratio = emscripten_get_device_pixel_ratio();
+    int width = std::min(std::max((int)(cssWidth * ratio + 0.5), 1), MAX_CANVAS_SIZE);
+    int height = std::min(std::max((int)(cssHeight * ratio + 0.5), 1), MAX_CANVAS_SIZE);
+    if (width != GetScreenWidth() || height != GetScreenHeight()) SetWindowSize(width, height);
+}
+#endif
+
+// Fits the layout into the framebuffer, centered
+void VirtualScreen::Layout() {
+    int width = GetScreenWidth(), height = GetScreenHeight();
+    if (width == screenWidth && height == screenHeight) return;
+    screenWidth = width;
+    screenHeight = height;
+    fitScale = std::min((float)width / SCREEN_WIDTH, (float)height / SCREEN_HEIGHT);
+    destination.width = SCREEN_WIDTH * fitScale;
+    destination.height = SCREEN_HEIGHT * fitScale;
+    destination.x = (width - destination.width) / 2;
+    destination.y = (height - destination.height) / 2;
+    // raylib reports (raw + offset) * scale
+    SetMouseOffset((int)-destination.x, (int)-destination.y);
+    SetMouseScale(1.0f / fitScale, 1.0f / fitScale);
+}
+
+void VirtualScreen::EnsureTarget() {
+    int width = std::max((int)(SCREEN_WIDTH * RenderScale() + 0.5f), 1);
+    int height = std::max((int)(SCREEN_HEIGHT * RenderScale() + 0.5f), 1);
+    if (target.id != 0 && target.texture.width == width && target.texture.height == height) return;
+    if (target.id != 0) UnloadRenderTexture(target);
+    target = LoadRenderTexture(width, height);
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    printf("Render resolution %dx%d (%.0f%% of %dx%d)\n", width, height, QUALITY_SCALES[quality] * 100.0f,
+           (int)destination.width, (int)destination.height);
+}
+
+void VirtualScreen::Update() {
+    frameStart = std::chrono::steady_clock::now();
+#if defined(PLATFORM_WEB)
+    if (canvasDirty) FitCanvas();
+#endif
+    Layout();
+}
+
+void VirtualScreen::BeginScene() {
+    EnsureTarget();
+    BeginTextureMode(target);
+    Camera2D camera = { { 0, 0 }, { 0, 0 }, 0.0f, (float)target.texture.width / SCREEN_WIDTH };
+    BeginMode2D(camera);
+}
+
+void VirtualScreen::EndScene() {
+    EndMode2D();
+    EndTextureMode();
+    ClearBackground(BLACK); // Letterbox bars
+    // Render targets are stored bottom-up
+    Rectangle source = { 0, 0, (float)target.texture.width, -(float)target.texture.height };
+    DrawTexturePro(target.texture, source, destination, { 0, 0 }, 0.0f, WHITE);
+    // Work time, not the frame interval: EffectQuality.h governs the resolution from it
+    float cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    // The GPU draws (fill, the scale-up) after the CPU has moved on, so every so often wait for
+    // it: flush the batch and read a pixel back, which returns once the frame is drawn. The
+    // swap is not waited for, so vsync stays out of it. Frames in between reuse the sample.
+    if (++framesSinceGpuSample >= GPU_SAMPLE_INTERVAL) {
+        framesSinceGpuSample = 0;
+        rlDrawRenderBatchActive();
+        MemFree(rlReadScreenPixels(1, 1));
+        float drawnMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+        gpuTailMs = drawnMs - cpuMs;
+    }
+    lastWorkMs = cpuMs + gpuTailMs;
+}
+
+void VirtualScreen::SetResolutionLevel(int level) {
+    quality = std::min(std::max(level, 0), RESOLUTION_LEVELS - 1); // EnsureTarget resizes the target next frame
+}
+
+Vector2 VirtualScreen::ScreenToVirtual(Vector2 screen) const {
+    if (fitScale <= 0.0f) return screen;
+    return { (screen.x - destination.x) / fitScale, (screen.y - destination.y) / fitScale };
+}
+
+#if defined(PLATFORM_WEB)
+Vector2 VirtualScreen::CssToVirtual(float x, float y) const {
+    if (cssWidth <= 0.0 || cssHeight <= 0.0) return { 0, 0 };
+    return ScreenToVirtual({ (float)(x * screenWidth / cssWidth), (float)(y * screenHeight / cssHeight) });
+}
+#endif
@@ -0,0 +1,74 @@
+#ifndef VIRTUAL_SCREEN_H
+#define VIRTUAL_SCREEN_H
+
+#include "raylib.h"
+#include <chrono>
+
+// --- Virtual screen ---
+// Everything is laid out and drawn in SCREEN_WIDTH x SCREEN_HEIGHT coordinates. The scene is
+// drawn into a render target at an internal resolution, then scaled into the largest 4:3
+// area of the real framebuffer (letterboxed): the window natively, and on the web the canvas
+// backing store, sized to the canvas's CSS size times devicePixelRatio so high-DPI screens
+// get every device pixel. The mouse is mapped back to layout coordinates.
+// The internal resolution starts at that full size; EffectQuality.h lowers it a level at a
+// time, after the optional effects, while frames take longer than the budget to draw (weak
+// GPUs, huge canvases), and raises it again once there is headroom.
+
+const int SCREEN_WIDTH = 800;
+const int SCREEN_HEIGHT = 600;
+
+class VirtualScreen {
+public:
+    static VirtualScreen& Get();
+
+    void Init(); // After InitWindow
+    // First thing in the frame, before input is read: follows window/canvas size changes
+    void Update();
+
+    // Between BeginDrawing and EndDrawing: the scene goes into the render target in between
+    void BeginScene();
+    void EndScene();
+
+    // Framebuffer pixels to layout coordinates (raylib's mouse position is mapped already)
+    Vector2 ScreenToVirtual(Vector2 screen) const;
+#if defined(PLATFORM_WEB)
+    // Canvas CSS pixels (DOM mouse events) to layout coordinates
+    Vector2 CssToVirtual(float x, float y) const;
+    void CanvasResized() { canvasDirty = true; } // Window resize: CSS size or pixel ratio may have changed
+#endif
+
+    float RenderScale() const { return fitScale * QUALITY_SCALES[quality]; } // Target pixels per layout unit
+
+    // Resolution levels, 0 = full; the target is resized on the next frame
+    static const int RESOLUTION_LEVELS = 5;
+    void SetResolutionLevel(int level);
+
+    // The last frame's work time, in milliseconds: Update to EndScene on the CPU, plus how long
+    // the GPU then took to finish drawing (sampled every few frames; the vsync wait excluded)
+    float LastWorkMs() const { return lastWorkMs; }
+
+private:
+    static const float QUALITY_SCALES[RESOLUTION_LEVELS];
+
+    RenderTexture2D target = {};
+    int screenWidth = 0, screenHeight = 0; // Framebuffer the layout was computed for
+    float fitScale = 1.0f;                 // Framebuffer pixels per layout unit
+    Rectangle destination = { 0, 0, 0, 0 };
+    int quality = 0;                       // Index into QUALITY_SCALES, 0 = full resolution
+    std::chrono::steady_clock::time_point frameStart; // Set by Update
+    float lastWorkMs = 0.0f;
+    float gpuTailMs = 0.0f;                // From the last GPU sample
+    int framesSinceGpuSample = 0;
+
+#if defined(PLATFORM_WEB)
+    bool canvasDirty = true;
+    double cssWidth = 0.0, cssHeight = 0.0;
+    void FitCanvas();
+#endif
+
+    VirtualScreen() {}
+    void Layout();
+    void EnsureTarget();
+};
+
+#endif
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Generates the typed C++ -> JS interop messages from interop_messages.txt.
+
+Outputs:
+  InteropMessages.h    - structs + SendInteropMessage() overloads (write into InteropChannel)
+  interop_messages.js  - Module.interopDecoders, passed to em++ with --pre-js
+"""
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SCHEMA = os.path.join(HERE, "interop_messages.txt")
+
+# type -> (C++ type, size, ByteWriter-style put, DataView getter)
+TYPES = {
+    "u8":  ("uint8_t",  1, "getUint8"),
+    "u16": ("uint16_t", 2, "getUint16"),
+    "u32": ("uint32_t", 4, "getUint32"),
+    "i32": ("int32_t",  4, "getInt32"),
+    "f32": ("float",    4, "getFloat32"),
+    "f64": ("double",   8, "getFloat64"),
+}
+
+
+def parse(path):
+    messages = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            parts = line.split()
+            fields = []
+            for part in parts[1:]:
+                name, _, kind = part.partition(":")
+                if kind not in TYPES:
+                    sys.exit("%s:%d: unknown type '%s'" % (path, number, kind))
+                fields.append((name, kind))
+            messages.append((parts[0], fields))
+    if len(messages) > 255:
+        sys.exit("too many messages (type ids are one byte)")
+    return messages
+
+
+def constant(name):
+    out = ""
+    for i, c in enumerate(name):
+        if c.isupper() and i > 0:
+            out += "_"
+        out += c.upper()
+    return "MSG_" + out
+
+
+def cpp(messages):
+    lines = [
+        "// GENERATED by gen_interop.py from interop_messages.txt - do not edit by hand",
+        "#ifndef INTEROP_MESSAGES_H",
+        "#define INTEROP_MESSAGES_H",
+        "",
+        '#include "InteropChannel.h"',
+        "#include <cstring>",
+        "",
+        "enum InteropMessageType : uint8_t {",
+    ]
+    for i, (name, _) in enumerate(messages):
+        lines.append("    %s = %d," % (constant(name), i + 1))
+    lines += ["};", ""]
+    for name, fields in messages:
+        lines.append("struct Msg%s {" % name)
+        for field, kind in fields:
+            lines.append("    %s %s;" % (TYPES[kind][0], field))
+        lines += ["};", ""]
+    for name, fields in messages:
+        size = sum(TYPES[kind][1] for _, kind in fields)
+        param = "const Msg%s& m" % name if fields else "const Msg%s&" % name
+        lines.append("inline bool SendInteropMessage(%s) {" % param)
+        lines.append("    uint8_t* p = InteropChannel::Get().Reserve(%s, %d);" % (constant(name), size))
+        lines.append("    if (!p) return false;")
+        offset = 0
+        for field, kind in fields:
+            lines.append("    memcpy(p + %d, &m.%s, %d);" % (offset, field, TYPES[kind][1]))
+            offset += TYPES[kind][1]
+        lines += ["    return true;", "}", ""]
+    lines += ["#endif", ""]
+    return "\n".join(lines)
+
+
+def js(messages):
+    lines = [
+        "// GENERATED by gen_interop.py from interop_messages.txt - do not edit by hand",
+        "// Decoders for the C++ -> JS interop channel (see InteropChannel.h); handlers go in",
+        "// Module.interopHandlers, keyed by message type name.",
+        "Module.interopDecoders = {",
+    ]
+    for i, (name, fields) in enumerate(messages):
+        lines.append("  %d: function(view, at) {" % (i + 1))
+        lines.append("    return {")
+        lines.append("      type: '%s'," % name)
+        offset = 0
+        for field, kind in fields:
+            size = TYPES[kind][1]
+            little = "" if size == 1 else ", true"
+            lines.append("      %s: view.%s(at + %d%s)," % (field, TYPES[kind][2], offset, little))
+            offset += size
+        lines.append("    };")
+        lines.append("  },")
+    lines += ["};", ""]
+    return "\n".join(lines)
+
+
+def main():
+    messages = parse(SCHEMA)
+    with open(os.path.join(HERE, "InteropMessages.h"), "w") as f:
+        f.write(cpp(messages))
+    with open(os.path.join(HERE, "interop_messages.js"), "w") as f:
+        f.write(js(messages))
+    print("Generated %d interop messages" % len(messages))
+
+
+if __name__ == "__main__":
+    main()
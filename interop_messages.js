@@ -0,0 +1,45 @@
+// GENERATED by gen_interop.py from interop_messages.txt - do not edit by hand
+// Decoders for the C++ -> JS interop channel (see InteropChannel.h); handlers go in
+// Module.interopHandlers, keyed by message type name.
+Module.interopDecoders = {
+  1: function(view, at) {
+    return {
+      type: 'ScoreSubmitted',
+      score: view.getInt32(at + 0, true),
+      sortOrder: view.getUint8(at + 4),
+      elapsedMs: view.getInt32(at + 5, true),
+    };
+  },
+  2: function(view, at) {
+    return {
+      type: 'LeaderboardRefresh',
+    };
+  },
+  3: function(view, at) {
+    return {
+      type: 'GameFinished',
+      game: view.getUint8(at + 0),
+      difficulty: view.getUint8(at + 1),
+      seconds: view.getInt32(at + 2, true),
+      score: view.getInt32(at + 6, true),
+      moves: view.getInt32(at + 10, true),
+      errors: view.getInt32(at + 14, true),
+    };
+  },
+  4: function(view, at) {
+    return {
+      type: 'TelemetryEvent',
+      event: view.getUint8(at + 0),
+      arg: view.getUint8(at + 1),
+      value: view.getUint16(at + 2, true),
+      timeMs: view.getUint32(at + 4, true),
+    };
+  },
+  5: function(view, at) {
+    return {
+      type: 'StartupMark',
+      phase: view.getUint8(at + 0),
+      ms: view.getFloat64(at + 1, true),
+    };
+  },
+};
@@ -1,38 +1,179 @@
 #include "js_interop.h"
+#include "RenderWorker.h"
+#include "raylib.h"
 #include <cstdio> // For printf in the desktop stubs
 
 // --- EM_JS Definitions (Used only when PLATFORM_WEB is defined) ---
 #if defined(PLATFORM_WEB)
 #include <emscripten.h>
+#include <atomic>
 
-// CORRECT SYNTAX: Parameters are in one set of parentheses: (int score, int sortOrder)
-EM_JS(void, SaveScoreToBrowser, (int score, int sortOrder), {
-    if (typeof window.updateLeaderboard === 'function') {
-        window.updateLeaderboard(score, sortOrder);
-    } else {
-        console.warn("updateLeaderboard() missing in window");
+#include "InteropMessages.h"
+
+// Set by the page thread once IDBFS has loaded; polled by the frame loop without a JS call
+static std::atomic<int> saveStorageReady{0};
+
+// Score events are queued on the interop channel; the page sees them when the frame's
+// batch is drained (Module.interopHandlers in minshell.html)
+int SaveScoreToBrowser(int score, int sortOrder, int elapsedMs) {
+    MsgScoreSubmitted message = { score, (uint8_t)sortOrder, elapsedMs };
+    SendInteropMessage(message);
+    return 0;
+}
+
+void RefreshLeaderboard() {
+    SendInteropMessage(MsgLeaderboardRefresh());
+}
+
+// One call per frame for all queued messages. Decoders are generated (interop_messages.js,
+// linked with --pre-js); messages without a handler are skipped. head/tail go through
+// Atomics: in the worker build the writer is another thread (InteropChannel.h).
+EM_JS(void, DrainInteropChannel, (void* header, void* ring), {
+    const view = new DataView(HEAPU8.buffer);
+    const head = Atomics.load(HEAPU32, header >> 2);
+    let tail = Atomics.load(HEAPU32, (header + 4) >> 2);
+    const decoders = Module.interopDecoders || {};
+    const handlers = Module.interopHandlers || {};
+    while (tail !== head) {
+        const type = HEAPU8[ring + tail];
+        if (type === 0) { tail = 0; continue; } // Padding: wrap to the start
+        const size = HEAPU8[ring + tail + 1] | (HEAPU8[ring + tail + 2] << 8);
+        const decode = decoders[type];
+        if (decode) {
+            const message = decode(view, ring + tail + 3);
+            const handler = handlers[message.type];
+            if (handler) {
+                try { handler(message); } catch (e) { console.warn("Interop handler failed:", e); }
+            }
+        } else {
+            console.warn("Unknown interop message type", type);
+        }
+        tail += 3 + size;
     }
+    Atomics.store(HEAPU32, (header + 4) >> 2, tail);
+    Atomics.store(HEAPU32, (header + 16) >> 2, 0); // Header.draining
 });
 
-// CORRECT SYNTAX: No parameters are in one set of parentheses: ()
-EM_JS(void, RefreshLeaderboard, (), {
-    if (typeof window.refreshLeaderboard === 'function') {
-        window.refreshLeaderboard();
-    } else {
-        console.warn("refreshLeaderboard() missing in window");
+// Mounts IndexedDB-backed storage at /save and pulls existing saves into memory.
+// Requires linking with -lidbfs.js
+EM_JS(void, MountSaveStorageJs, (int* ready), {
+    Module.saveStorageReady = 0;
+    Module.saveSyncInFlight = false;
+    const loaded = function() {
+        if (Module.markStartup) Module.markStartup('storage'); // StartupTimeline.h
+        Module.saveStorageReady = 1;
+        Atomics.store(HEAP32, ready >> 2, 1);
+    };
+    try {
+        FS.mkdir('/save');
+        FS.mount(IDBFS, {}, '/save');
+        FS.syncfs(true, function(err) {
+            if (err) console.warn("Save storage load failed:", err);
+            loaded();
+        });
+    } catch (e) {
+        console.warn("Save storage unavailable:", e);
+        loaded();
     }
 });
 
-// --- Desktop stub definitions (Used when PLATFORM_WEB is NOT defined) ---
+// Flushes /save to IndexedDB. Coalesces requests so frequent autosaves never queue up syncs.
+EM_JS(void, PersistSaveStorageJs, (), {
+    if (!Module.saveStorageReady) return;
+    if (Module.saveSyncInFlight) { Module.saveSyncPending = true; return; }
+    Module.saveSyncInFlight = true;
+    const done = function(err) {
+        if (err) console.warn("Save storage sync failed:", err);
+        if (Module.saveSyncPending) {
+            Module.saveSyncPending = false;
+            FS.syncfs(false, done);
+        } else {
+            Module.saveSyncInFlight = false;
+        }
+    };
+    FS.syncfs(false, done);
+});
+
+// FS and IDBFS live on the page thread
+void MountSaveStorage() {
+    RunOnPageThread([]() { MountSaveStorageJs((int*)&saveStorageReady); });
+}
+
+int IsSaveStorageReady() {
+    return saveStorageReady.load(std::memory_order_acquire);
+}
+
+// The file writes before this already went through the page thread's FS, so a queued sync sees them
+void PersistSaveStorage() {
+    PostToPageThread([]() { PersistSaveStorageJs(); });
+}
+
+EM_JS(void, WriteClipboardJs, (const char* text), {
+    if (!navigator.clipboard) return;
+    navigator.clipboard.writeText(UTF8ToString(text)).catch(function(e) { console.warn("Clipboard write failed:", e); });
+});
+
+void CopyToClipboard(const char* text) {
+#if WORKER_RENDERING
+    RunOnPageThread([text]() { WriteClipboardJs(text); });
+#else
+    SetClipboardText(text);
+#endif
+}
+
+// --- Desktop definitions (Used when PLATFORM_WEB is NOT defined) ---
 #else 
+#include "ScoreDatabase.h"
+#include "LeaderboardScreen.h"
+#include <cstdlib>
+
+// Leaderboard size printed by RefreshLeaderboard (the web page shows its top 20; the menu's
+// Leaderboard screen, LeaderboardScreen.h, its top LeaderboardScreen::ROWS)
+const int DESKTOP_LEADERBOARD_SIZE = 10;
+
+// No name prompt natively: use the OS account name
+static std::string DesktopPlayerName() {
+    const char* name = getenv("USER");
+    if (!name || !*name) name = getenv("USERNAME");
+    return (name && *name) ? name : "Player";
+}
+
+static void PrintBoard(ScoreBoard board) {
+    const char* title = (board == BOARD_MEMORY) ? "Memory (low is better)" : "Killer Sudoku (high is better)";
+    printf("--- Top Scores: %s, %d total ---\n", title, ScoreDatabase::Get().Count(board));
+    std::vector<ScoreEntry> top = ScoreDatabase::Get().TopK(board, DESKTOP_LEADERBOARD_SIZE);
+    for (size_t i = 0; i < top.size(); i++) {
+        if (top[i].elapsedMs == SCORE_NO_TIME) printf("#%zu %-10.10s %d\n", i + 1, top[i].name.c_str(), top[i].score);
+        else printf("#%zu %-10.10s %d  %.3fs\n", i + 1, top[i].name.c_str(), top[i].score, top[i].elapsedMs / 1000.0);
+    }
+}
+
 // NOTE: For a clean fix, you MUST ensure that SaveScoreToBrowser and RefreshLeaderboard
 // in js_interop.h are wrapped in 'extern "C"' (conditionally, or always).
-void SaveScoreToBrowser(int score, int sortOrder) {
-    const char* mode = (sortOrder == 1) ? "High is Better" : "Low is Better";
-    printf("[Desktop Stub] Score Saved: %d (%s)\n", score, mode);
+int SaveScoreToBrowser(int score, int sortOrder, int elapsedMs) {
+    ScoreBoard board = (sortOrder == 1) ? BOARD_SUDOKU : BOARD_MEMORY;
+    int rank = ScoreDatabase::Get().Insert(board, DesktopPlayerName(), score, elapsedMs);
+    printf("Score saved: %d (%.3fs), rank #%d of %d\n", score, elapsedMs / 1000.0, rank, ScoreDatabase::Get().Count(board));
+    PrintBoard(board);
+    LeaderboardScreen::Get().NoteScore(board, rank, score, elapsedMs);
+    return rank;
 }
 
 void RefreshLeaderboard() {
-    printf("[Desktop Stub] Refresh Leaderboard\n");
+    PrintBoard(BOARD_MEMORY);
+    PrintBoard(BOARD_SUDOKU);
+}
+
+// Native saves are plain files in the working directory, nothing to mount or flush
+void MountSaveStorage() {}
+
+int IsSaveStorageReady() {
+    return 1;
+}
+
+void PersistSaveStorage() {}
+
+void CopyToClipboard(const char* text) {
+    SetClipboardText(text);
 }
 #endif
\ No newline at end of file
@@ -7,9 +7,25 @@
 extern "C" {
 #endif
 
-void SaveScoreToBrowser(int score, int sortOrder);
+// elapsedMs: the game's time to the millisecond, breaks ties between equal scores.
+// Returns the score's rank on the local leaderboard natively; 0 on the web, where the page ranks it.
+int SaveScoreToBrowser(int score, int sortOrder, int elapsedMs);
 void RefreshLeaderboard();
 
+// Save storage (IDBFS on the web, plain files natively)
+void MountSaveStorage();
+int IsSaveStorageReady();
+void PersistSaveStorage();
+
+// raylib's SetClipboardText, except from the worker build's render thread (no clipboard there)
+void CopyToClipboard(const char* text);
+
+#if defined(PLATFORM_WEB)
+// Decodes and dispatches every pending InteropChannel message, then advances its tail.
+// Page thread only (see RenderWorker.h).
+void DrainInteropChannel(void* header, void* ring);
+#endif
+
 #ifdef __cplusplus
 } // End extern "C"
 #endif
@@ -2,115 +2,362 @@
 #include <cstdio> 
 
 // Game Headers
-#include "KillerSudoku.h"
-#include "MemoryGame.h"
+#include "GameModule.h"
+#include "js_interop.h"
+#include "PuzzleCode.h"
+#include "JobSystem.h"
+#include "PlayerStats.h"
+#include "LeaderboardScreen.h"
+#include "InteropChannel.h"
+#include "Telemetry.h"
+#include "FrameWatchdog.h"
+#include "InputLatency.h"
+#include "GameInput.h"
+#include "RenderWorker.h"
+#include "FixedTimestep.h"
+#include "StartupTimeline.h"
+#include "VirtualScreen.h"
+#include "EffectQuality.h"
+#include "SpriteAtlas.h"
+#include "AudioFeedback.h"
+#include "UiScreen.h"
 #include <emscripten/emscripten.h>
+#include <memory>
 
 // --- Constants ---
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
+const double AUTOSAVE_INTERVAL = 5.0; // Seconds between snapshots of an in-progress game
+const double IDLE_PREFETCH_DELAY = 3.0; // Seconds on the menu before every game's code is fetched anyway
 
 // --- Enums ---
 enum AppState {
     APP_MAIN_MENU,
     APP_MEMORY_GAME,
-    APP_SUDOKU_GAME
+    APP_SUDOKU_GAME,
+    APP_STATS,
+    APP_LEADERBOARD // Natively; on the web the page shows the online board
 };
 
 // --- Globals ---
 AppState appState = APP_MAIN_MENU;
 
-// Game Instances
-KillerSudokuGame sudokuGame;
-MemoryGame memoryGame;
+// The game being played: created on entering it, released on returning to the menu
+std::unique_ptr<GameModule> currentGame;
+GameId pendingGame = GAME_COUNT; // Clicked in the menu while its code was still loading
+std::string pendingCode;         // Share code waiting for its game's code
+double menuSince = 0.0;          // When the menu was last entered
+
+double lastAutosaveTime = 0.0;
+FixedTimestep simulation; // Paces game simulation independently of the display rate
+
+const char* APP_STATE_NAMES[] = { "Main menu", "Memory", "Killer Sudoku", "Player stats", "Leaderboard" };
+
+UiScreen mainMenu;
+int btnMemory, btnSudoku, btnStats, btnLeaderboard = -1;
 
 void UpdateDrawFrame(void);
 
+// Starts the frame's drawing, in layout coordinates (VirtualScreen.h)
+static void BeginFrameDrawing() {
+    BeginDrawing();
+    VirtualScreen::Get().BeginScene();
+    ClearBackground(RAYWHITE);
+}
+
+// Ends the frame's drawing with the diagnostic overlays on top. Timed: natively it includes the FPS wait.
+static void PresentFrame() {
+    StartupTimeline::Get().DrawOverlay();
+    FrameWatchdog::Get().DrawOverlay();
+    VirtualScreen::Get().EndScene();
+    {
+        ProfileSpan span("Present");
+        EndDrawing();
+    }
+    InputLatency::Get().AfterPresent();
+    StartupTimeline::Get().AfterPresent(IsSaveStorageReady());
+}
+
+// Declared once; hovering and labels are all that change between frames
+static void BuildMainMenu() {
+    const UiStyle memoryStyle = { LIGHTGRAY, SKYBLUE, DARKGRAY, DARKGRAY, 2, 20 };
+    const UiStyle sudokuStyle = { LIGHTGRAY, GOLD, DARKGRAY, DARKGRAY, 2, 20 };
+    btnMemory = mainMenu.AddButton({ (float)SCREEN_WIDTH/2 - 120, 250, 240, 60 }, "Memory Game", memoryStyle);
+    btnSudoku = mainMenu.AddButton({ (float)SCREEN_WIDTH/2 - 120, 340, 240, 60 }, "Killer Sudoku", sudokuStyle);
+    btnStats = mainMenu.AddButton({ (float)SCREEN_WIDTH/2 - 120, 480, 240, 40 }, "Player Stats", memoryStyle);
+#if !defined(PLATFORM_WEB)
+    btnLeaderboard = mainMenu.AddButton({ (float)SCREEN_WIDTH/2 - 120, 530, 240, 40 }, "Leaderboard", memoryStyle);
+#endif
+}
+
+// Only built when a frame went over budget
+static const char* DescribeGameState() {
+    return currentGame ? currentGame->DescribeState() : "";
+}
+
+// The JS-called entry points below may run on the page thread (worker build); they hop to
+// the render thread, where the games live, and wait for it.
+
+// Snapshots whichever game is in progress. Also called from JS when the tab is hidden/closed.
+extern "C" EMSCRIPTEN_KEEPALIVE void SaveGamesNow() {
+    RunOnRenderThread([]() {
+        if (currentGame && currentGame->HasGameInProgress()) currentGame->SaveSnapshot();
+        lastAutosaveTime = GetTime();
+    });
+}
+
+// Stops both game clocks while the app is hidden. Called from JS on visibility changes;
+// natively the main loop calls it when the window is minimized or restored.
+extern "C" EMSCRIPTEN_KEEPALIVE void SetGamesPaused(int paused) {
+    RunOnRenderThread([paused]() {
+        if (currentGame) currentGame->SetPaused(paused != 0);
+    });
+}
+
+static AppState GameAppState(GameId game) {
+    return (game == GAME_MEMORY) ? APP_MEMORY_GAME : APP_SUDOKU_GAME;
+}
+
+// Replaces whatever game was running (already snapshotted) with 'game'
+static void EnterGame(GameId game, GameModule* instance) {
+    currentGame.reset(instance);
+    appState = GameAppState(game);
+    simulation.Reset();
+    lastAutosaveTime = GetTime();
+}
+
+static int StartSharedCode(const std::string& code) {
+    GameId game = (code[0] == 'K') ? GAME_SUDOKU : GAME_MEMORY;
+    std::unique_ptr<GameModule> instance(GameModules::Get().Create(game));
+    if (!instance) {
+        pendingCode = code; // Started by StartPendingGame once the code is loaded
+        return 1;
+    }
+    SaveGamesNow(); // Don't lose whatever was in progress
+    if (!instance->StartFromCode(code)) {
+        printf("Invalid puzzle code: %s\n", code.c_str());
+        return 0;
+    }
+    EnterGame(game, instance.release());
+    return 1;
+}
+
+// Starts the game asked for by a menu click or share code as soon as its module has loaded
+static void StartPendingGame() {
+    if (!pendingCode.empty()) {
+        GameId game = (pendingCode[0] == 'K') ? GAME_SUDOKU : GAME_MEMORY;
+        if (GameModules::Get().IsLoaded(game)) {
+            std::string code;
+            code.swap(pendingCode);
+            StartSharedCode(code);
+        } else if (GameModules::Get().HasFailed(game)) {
+            pendingCode.clear();
+        }
+    }
+    if (pendingGame != GAME_COUNT && appState == APP_MAIN_MENU) {
+        GameModule* instance = GameModules::Get().Create(pendingGame);
+        if (instance) {
+            ProfileSpan span("Open game");
+            instance->Open(IsSaveStorageReady()); // Resume an interrupted game if there is a snapshot for it
+            EnterGame(pendingGame, instance);
+            pendingGame = GAME_COUNT;
+        } else if (GameModules::Get().HasFailed(pendingGame)) {
+            pendingGame = GAME_COUNT;
+        }
+    }
+}
+
+// Starts the puzzle described by a share code (or a "?p=" link). Called from JS on paste.
+// With split game modules it may only start once that game's code has loaded.
+extern "C" EMSCRIPTEN_KEEPALIVE int PlaySharedCode(const char* text) {
+    std::string code = ExtractPuzzleCode(text);
+    if (code.empty()) return 0;
+    if (code[0] != 'K' && code[0] != 'M') {
+        printf("Invalid puzzle code: %s\n", code.c_str());
+        return 0;
+    }
+    int started = 0;
+    RunOnRenderThread([&]() { started = StartSharedCode(code); });
+    return started;
+}
+
 // --- Main ---
-int main() {
+int main(int argc, char** argv) {
+    StartupTimeline::Get().Mark(STARTUP_MAIN);
+    PrepareRenderCanvas();
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Raylib Game Arcade");
-    
-    // Initialize Games
-    sudokuGame.Init();
-    memoryGame.Init();
+    StartupTimeline::Get().Mark(STARTUP_WINDOW);
+    VirtualScreen::Get().Init();
+    SpriteAtlas::Get().Load();
+    AudioFeedback::Get().Init();
+    MountSaveStorage();
+    if (IsSaveStorageReady()) StartupTimeline::Get().Mark(STARTUP_STORAGE); // Natively; the page marks its IDBFS load
+    JobSystem::Get().Start(); // Inline-only in the single-threaded web build
+
+    // A share code on the command line (the web shell passes "?p=" this way)
+    if (argc > 1) PlaySharedCode(argv[1]);
 
 #if defined(PLATFORM_WEB)
     emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
 #else
     SetTargetFPS(60);
+    bool minimized = false;
     while (!WindowShouldClose()) {
+        if (IsWindowMinimized() != minimized) {
+            minimized = !minimized;
+            SetGamesPaused(minimized);
+        }
         UpdateDrawFrame();
     }
 #endif
 
+    Telemetry::Get().Flush(true);
+    printf("%s", InputLatency::Get().FormatReport().c_str());
+    JobSystem::Get().Shutdown();
+    AudioFeedback::Get().Shutdown();
     CloseWindow();
     return 0;
 }
 
 // --- MAIN LOOP ---
 void UpdateDrawFrame() {
+    VirtualScreen::Get().Update(); // Maps this frame's pointer to the current layout
+    EffectQuality::Get().Update(VirtualScreen::Get().LastWorkMs()); // Settles this frame's effects and resolution before anything draws
+    BeginInputFrame();
+    FrameWatchdog::Get().BeginFrame();
+    FrameWatchdog::Get().Update();
+    StartupTimeline::Get().Update();
+    InputLatency::Get().BeginFrame();
+    StartPendingGame();
+    AppState frameStartState = appState;
+
     switch(appState) {
 
         case APP_MAIN_MENU: {
-            BeginDrawing();
-            ClearBackground(RAYWHITE);
+            BeginFrameDrawing();
             
             DrawText("ARCADE MENU", SCREEN_WIDTH/2 - MeasureText("ARCADE MENU", 50)/2, 100, 50, DARKGRAY);
             
-            Rectangle btnMem = { (float)SCREEN_WIDTH/2 - 120, 250, 240, 60 };
-            Rectangle btnSud = { (float)SCREEN_WIDTH/2 - 120, 340, 240, 60 };
-            
-            Vector2 mousePos = GetMousePosition();
-            bool click = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
-            
-            DrawRectangleRec(btnMem, CheckCollisionPointRec(mousePos, btnMem) ? SKYBLUE : LIGHTGRAY);
-            DrawRectangleLinesEx(btnMem, 2, DARKGRAY);
-            DrawText("Memory Game", btnMem.x + 40, btnMem.y + 20, 20, DARKGRAY);
-            
-            DrawRectangleRec(btnSud, CheckCollisionPointRec(mousePos, btnSud) ? GOLD : LIGHTGRAY);
-            DrawRectangleLinesEx(btnSud, 2, DARKGRAY);
-            DrawText("Killer Sudoku", btnSud.x + 40, btnSud.y + 20, 20, DARKGRAY);
+            if (!mainMenu.IsBuilt()) BuildMainMenu();
+            mainMenu.SetLabel(btnMemory, pendingGame == GAME_MEMORY ? "Loading..." : "Memory Game");
+            mainMenu.SetLabel(btnSudoku, pendingGame == GAME_SUDOKU ? "Loading..." : "Killer Sudoku");
+            mainMenu.SetEnabled(btnStats, IsSaveStorageReady());
+            mainMenu.Update();
+
+            // Hovering a game starts fetching its code, so it is usually there by the click
+            if (mainMenu.Hovered(btnMemory)) GameModules::Get().Prefetch(GAME_MEMORY);
+            if (mainMenu.Hovered(btnSudoku)) GameModules::Get().Prefetch(GAME_SUDOKU);
+
+            mainMenu.Draw();
+
+            const char* pasteHint = "Paste a puzzle code (Ctrl+V) to play a friend's board";
+            DrawText(pasteHint, SCREEN_WIDTH/2 - MeasureText(pasteHint, 16)/2, 440, 16, GRAY);
+
+#if !defined(PLATFORM_WEB)
+            // On the web the browser's paste event is forwarded from minshell.html instead
+            if ((InputKeyDown(KEY_LEFT_CONTROL) || InputKeyDown(KEY_RIGHT_CONTROL)) && InputKeyPressed(KEY_V)) {
+                PlaySharedCode(GetClipboardText());
+            }
+#endif
             
-            if (click) {
-                if (CheckCollisionPointRec(mousePos, btnMem)) {
-                    appState = APP_MEMORY_GAME;
-                    memoryGame.Init();
-                } else if (CheckCollisionPointRec(mousePos, btnSud)) {
-                    appState = APP_SUDOKU_GAME;
-                    sudokuGame.StartGame(S_MEDIUM); 
+            // A game opens right away if its code is loaded, else as soon as it is
+            if (mainMenu.Clicked(btnMemory) || mainMenu.Clicked(btnSudoku)) {
+                pendingGame = mainMenu.Clicked(btnMemory) ? GAME_MEMORY : GAME_SUDOKU;
+                StartPendingGame();
+            } else if (mainMenu.Clicked(btnStats)) {
+                ProfileSpan span("Open stats");
+                appState = APP_STATS;
+                PlayerStats::Get().Open();
+            } else if (btnLeaderboard >= 0 && mainMenu.Clicked(btnLeaderboard)) {
+                ProfileSpan span("Open leaderboard");
+                appState = APP_LEADERBOARD;
+                LeaderboardScreen::Get().Open();
+            }
+            PresentFrame();
+
+            // Idle time: fetch the remaining game code, then let loaded games do background
+            // work (Killer Sudoku stocks verified puzzles so a new game starts instantly)
+            if (appState == APP_MAIN_MENU && IsSaveStorageReady()) {
+                ProfileSpan span("Menu idle");
+                if (GetTime() - menuSince >= IDLE_PREFETCH_DELAY) {
+                    for (int g = 0; g < GAME_COUNT; g++) GameModules::Get().Prefetch((GameId)g);
                 }
+                GameModules::Get().Idle();
             }
-            EndDrawing();
         }
         break;
 
-        case APP_MEMORY_GAME: {
-            memoryGame.Update();
+        case APP_MEMORY_GAME:
+        case APP_SUDOKU_GAME: {
+            {
+                ProfileSpan span("Update");
+                currentGame->Update();
+            }
+            {
+                ProfileSpan span("Simulate");
+                int steps = simulation.Advance(GetFrameTime());
+                for (int i = 0; i < steps; i++) currentGame->Step(FixedTimestep::STEP);
+            }
             
-            BeginDrawing();
-            ClearBackground(RAYWHITE);
-            memoryGame.Draw();
-            EndDrawing();
+            BeginFrameDrawing();
+            {
+                ProfileSpan span("Draw");
+                currentGame->Draw(simulation.Alpha());
+            }
+            PresentFrame();
             
-            if (!memoryGame.IsActive()) {
+            if (!currentGame->IsActive()) {
+                ProfileSpan span("Leave game");
+                currentGame->Close();
+                currentGame.reset(); // The game's memory goes back to the allocator
                 appState = APP_MAIN_MENU;
-                memoryGame.ReturnToMenu();
+                menuSince = GetTime();
             }
         }
         break;
 
-        case APP_SUDOKU_GAME: {
-            sudokuGame.Update();
-            
-            BeginDrawing();
-            ClearBackground(RAYWHITE);
-            sudokuGame.Draw();
-            EndDrawing();
-            
-            if (!sudokuGame.IsActive()) {
+        case APP_STATS: {
+            PlayerStats::Get().Update();
+
+            BeginFrameDrawing();
+            PlayerStats::Get().Draw();
+            PresentFrame();
+
+            if (!PlayerStats::Get().IsActive()) {
                 appState = APP_MAIN_MENU;
             }
         }
         break;
+
+        case APP_LEADERBOARD: {
+            LeaderboardScreen::Get().Update();
+
+            BeginFrameDrawing();
+            LeaderboardScreen::Get().Draw();
+            PresentFrame();
+
+            if (!LeaderboardScreen::Get().IsActive()) {
+                appState = APP_MAIN_MENU;
+            }
+        }
+        break;
+    }
+
+    // Periodic autosave, after the frame is presented so it never delays input handling
+    if ((appState == APP_MEMORY_GAME || appState == APP_SUDOKU_GAME) && GetTime() - lastAutosaveTime >= AUTOSAVE_INTERVAL) {
+        ProfileSpan span("Autosave");
+        SaveGamesNow();
+    }
+
+    // Everything the frame queued for the page crosses to JS in one batch
+    {
+        ProfileSpan span("Flush");
+        Telemetry::Get().Flush();
+        InteropChannel::Get().Flush();
+    }
+
+    if (FrameWatchdog::Get().EndFrame()) {
+        const char* states = (frameStartState == appState)
+            ? APP_STATE_NAMES[appState]
+            : TextFormat("%s -> %s", APP_STATE_NAMES[frameStartState], APP_STATE_NAMES[appState]);
+        FrameWatchdog::Get().AnnotateHitch(states, DescribeGameState());
     }
 }
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Packs the web build for serving: content-hashed names plus precompressed variants.
+
+    python3 pack_assets.py [build dir (.)] [output dir (dist)]
+
+Outputs, in the output dir:
+  index.html            - loads the hashed files below through Module.locateFile; the only
+                          file a browser has to revalidate
+  index.<hash>.js/.wasm - and the side modules (memory.wasm, sudoku.wasm), the pthread
+                          worker script and index.data (atlas.png) when the build has
+                          them; never change once written, so they can be cached as immutable
+  sw.js                 - the offline cache (minshell.html registers it), set to precache the
+                          files above and serve them cache first
+  <file>.br, <file>.gz  - the same bytes precompressed at maximum level, picked by
+                          StaticServer.cpp from Accept-Encoding (.br needs the brotli module
+                          or the brotli command line tool)
+
+Hashed files from earlier runs are left in place: a page loaded before a deploy still finds them.
+"""
+import gzip
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+PAGE = "index.html"
+SERVICE_WORKER = "sw.js"  # Kept in the source tree, next to minshell.html
+# Loaded by the page or by index.js (the wasm, dlopen, pthreads, preloaded files); all go
+# through locateFile
+HASHED = ["index.js", "index.wasm", "index.data", "memory.wasm", "sudoku.wasm", "index.worker.js"]
+SERVICE_WORKER_SETTINGS = ("CACHE_NAME", "PRECACHE", "PACKED")
+COMPRESSED_EXTENSIONS = (".html", ".js", ".wasm")  # index.data holds a PNG already
+HASH_LENGTH = 10  # Hex digits; StaticServer.cpp treats name.<hex>.ext as immutable
+
+
+def content_hash(path):
+    with open(path, "rb") as f:
+        return hashlib.sha256(f.read()).hexdigest()[:HASH_LENGTH]
+
+
+def hashed_name(name, digest):
+    stem, ext = os.path.splitext(name)
+    return "%s.%s%s" % (stem, digest, ext)
+
+
+def rewrite_page(html, names):
+    # index.html comes from minshell.html through emcc's minifier, so match loosely
+    script = re.compile(r'src=(["\']?)index\.js\1')
+    if not script.search(html):
+        sys.exit("%s: no <script src=index.js>" % PAGE)
+    html = script.sub('src="%s"' % names["index.js"], html, count=1)
+
+    module = re.compile(r'var Module\s*=\s*\{')
+    if not module.search(html):
+        sys.exit("%s: no 'var Module = {'" % PAGE)
+    table = ",".join('"%s":"%s"' % (k, v) for k, v in sorted(names.items()))
+    locate = 'var Module={locateFile:function(p){return({%s})[p]||p},' % table
+    return module.sub(lambda _: locate, html, count=1)
+
+
+def rewrite_service_worker(script, names, html):
+    files = [PAGE] + sorted(names.values())
+    # index.html keeps its name, so the cache name follows its bytes (which hold the hashed names)
+    version = hashlib.sha256(html.encode()).hexdigest()[:HASH_LENGTH]
+    values = {
+        "CACHE_NAME": "'arcade-%s'" % version,
+        "PRECACHE": "[%s]" % ", ".join("'%s'" % f for f in files),
+        "PACKED": "true",
+    }
+    for name in SERVICE_WORKER_SETTINGS:
+        setting = re.compile(r"^const %s = .*;$" % name, re.M)
+        if not setting.search(script):
+            sys.exit("%s: no 'const %s = ...;' line" % (SERVICE_WORKER, name))
+        script = setting.sub(lambda _: "const %s = %s;" % (name, values[name]), script, count=1)
+    return script
+
+
+def brotli_compress(data):
+    try:
+        import brotli
+        return brotli.compress(data, quality=11)
+    except ImportError:
+        pass
+    if shutil.which("brotli"):
+        return subprocess.run(["brotli", "-c", "-q", "11"], input=data,
+                              stdout=subprocess.PIPE, check=True).stdout
+    return None
+
+
+def write_variants(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    written = []
+    # mtime=0 keeps the .gz bytes (and so ETags/caches downstream) stable across runs
+    variants = [(".gz", gzip.compress(data, compresslevel=9, mtime=0)),
+                (".br", brotli_compress(data))]
+    for suffix, packed in variants:
+        # Not worth a Content-Encoding if it does not save anything
+        if packed is None or len(packed) >= len(data):
+            continue
+        with open(path + suffix, "wb") as f:
+            f.write(packed)
+        written.append("%s %d" % (suffix, len(packed)))
+    return written
+
+
+def main():
+    build = os.path.abspath(sys.argv[1]) if len(sys.argv) > 1 else HERE
+    out = os.path.abspath(sys.argv[2]) if len(sys.argv) > 2 else os.path.join(build, "dist")
+    os.makedirs(out, exist_ok=True)
+
+    if not os.path.exists(os.path.join(build, PAGE)):
+        sys.exit("%s: not found in %s" % (PAGE, build))
+    if brotli_compress(b"") is None:
+        print("brotli not available (pip install brotli): writing .gz variants only")
+
+    names = {}
+    for name in HASHED:
+        source = os.path.join(build, name)
+        if os.path.exists(source):
+            names[name] = hashed_name(name, content_hash(source))
+            shutil.copyfile(source, os.path.join(out, names[name]))
+
+    with open(os.path.join(build, PAGE), encoding="utf-8") as f:
+        html = rewrite_page(f.read(), names)
+    with open(os.path.join(out, PAGE), "w", encoding="utf-8") as f:
+        f.write(html)
+
+    with open(os.path.join(HERE, SERVICE_WORKER), encoding="utf-8") as f:
+        script = rewrite_service_worker(f.read(), names, html)
+    with open(os.path.join(out, SERVICE_WORKER), "w", encoding="utf-8") as f:
+        f.write(script)
+
+    for name in [PAGE, SERVICE_WORKER] + [names[n] for n in HASHED if n in names]:
+        path = os.path.join(out, name)
+        variants = write_variants(path) if name.endswith(COMPRESSED_EXTENSIONS) else []
+        print("%-28s %9d  %s" % (name, os.path.getsize(path), "  ".join(variants)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+"""Packs the card and UI artwork in art/ into one texture atlas.
+
+    python3 pack_atlas.py
+
+Inputs (all optional; a missing file leaves its sprite empty and the game draws the flat
+colors instead):
+  art/cards/back.png, art/cards/face_00.png .. face_11.png  - one face per CARD_COLORS entry
+  art/ui/menu.png, help.png, back.png                       - button icons
+
+Outputs:
+  atlas.png       - every sprite, packed; em++ embeds it with --preload-file (see README)
+  AtlasSprites.h  - the sprite enum and each sprite's pixel rect in atlas.png
+
+Each sprite sits in a cell aligned to 2^MIP_LEVELS pixels, with its edge pixels extruded to
+fill the cell. Down to mip level MIP_LEVELS a mip texel never mixes two sprites, so cards
+drawn small (trilinear filtering) keep clean edges. Plain 8-bit PNGs only (no interlacing);
+no imaging library needed.
+"""
+import os
+import struct
+import sys
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ART = os.path.join(HERE, "art")
+ATLAS = "atlas.png"
+HEADER = "AtlasSprites.h"
+
+CARD_FACES = 12  # MemoryGame.cpp's CARD_COLORS
+SPRITES = ([("CARD_BACK", "cards/back.png")] +
+           [("CARD_FACE_%02d" % i, "cards/face_%02d.png" % i) for i in range(CARD_FACES)] +
+           [("ICON_MENU", "ui/menu.png"), ("ICON_HELP", "ui/help.png"), ("ICON_BACK", "ui/back.png")])
+MIP_LEVELS = 3            # Levels below full size that stay clean; GUTTER must cover the last one
+GUTTER = 1 << MIP_LEVELS  # Extruded pixels around each sprite, and the cell alignment
+MAX_SIZE = 4096           # Per side; what WebGL implementations reliably allow
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+
+
+# --- PNG ---
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Returns (width, height, RGBA rows as bytearrays)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(PNG_SIGNATURE):
+        sys.exit("%s: not a PNG" % path)
+    at, idat, palette, alpha = len(PNG_SIGNATURE), b"", None, b""
+    while at < len(data):
+        length, kind = struct.unpack(">I4s", data[at:at + 8])
+        body = data[at + 8:at + 8 + length]
+        at += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = body
+        elif kind == b"tRNS":
+            alpha = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if depth != 8 or interlace or channels is None:
+        sys.exit("%s: only 8-bit, non-interlaced PNGs are supported" % path)
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows, previous = [], bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        kind, row = raw[start], bytearray(raw[start + 1:start + 1 + stride])
+        for i in range(stride):
+            left = row[i - channels] if i >= channels else 0
+            up = previous[i]
+            upper_left = previous[i - channels] if i >= channels else 0
+            if kind == 1:
+                row[i] = (row[i] + left) & 255
+            elif kind == 2:
+                row[i] = (row[i] + up) & 255
+            elif kind == 3:
+                row[i] = (row[i] + ((left + up) >> 1)) & 255
+            elif kind == 4:
+                row[i] = (row[i] + paeth(left, up, upper_left)) & 255
+        previous = row
+        rows.append(to_rgba(row, color, palette, alpha))
+    return width, height, rows
+
+
+def to_rgba(row, color, palette, alpha):
+    if color == 6:
+        return row
+    out = bytearray()
+    if color == 2:
+        for i in range(0, len(row), 3):
+            out += row[i:i + 3] + b"\xff"
+    elif color == 0:
+        for v in row:
+            out += bytes((v, v, v, 255))
+    elif color == 4:
+        for i in range(0, len(row), 2):
+            out += bytes((row[i], row[i], row[i], row[i + 1]))
+    else:  # Palette
+        for v in row:
+            out += palette[v * 3:v * 3 + 3] + bytes((alpha[v] if v < len(alpha) else 255,))
+    return out
+
+
+def write_png(path, width, height, pixels):
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body))
+    stride = width * 4
+    raw = b"".join(b"\x00" + pixels[y * stride:(y + 1) * stride] for y in range(height))
+    with open(path, "wb") as f:
+        f.write(PNG_SIGNATURE)
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 6, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+# --- Packing ---
+
+def cell_size(width, height):
+    align = lambda v: (v + GUTTER - 1) // GUTTER * GUTTER
+    return align(width + 2 * GUTTER), align(height + 2 * GUTTER)
+
+
+def skyline_pack(cells, width, height):
+    """Bottom-left skyline packing. cells: [(w, h)]; returns [(x, y)] or None if they don't fit."""
+    skyline = [(0, 0, width)]  # (x, y, length) segments, left to right
+    places = [None] * len(cells)
+    # Tallest first keeps the skyline flat
+    for index in sorted(range(len(cells)), key=lambda i: (-cells[i][1], -cells[i][0])):
+        w, h = cells[index]
+        best = None
+        for start in range(len(skyline)):
+            x = skyline[start][0]
+            if x + w > width:
+                break
+            y, covered, i = 0, 0, start
+            while covered < w:
+                y = max(y, skyline[i][1])
+                covered += skyline[i][2] - (x - skyline[i][0] if i == start else 0)
+                i += 1
+            if y + h <= height and (best is None or (y + h, x) < (best[1] + h, best[0])):
+                best = (x, y)
+        if best is None:
+            return None
+        places[index] = best
+        x, y = best
+        # Raise the skyline under the new cell, then merge equal neighbours
+        updated = []
+        for sx, sy, length in skyline:
+            end = sx + length
+            if end <= x or sx >= x + w:
+                updated.append((sx, sy, length))
+                continue
+            if sx < x:
+                updated.append((sx, sy, x - sx))
+            if end > x + w:
+                updated.append((x + w, sy, end - x - w))
+        updated.append((x, y + h, w))
+        updated.sort()
+        skyline = []
+        for segment in updated:
+            if skyline and skyline[-1][1] == segment[1]:
+                skyline[-1] = (skyline[-1][0], segment[1], skyline[-1][2] + segment[2])
+            else:
+                skyline.append(segment)
+    return places
+
+
+def pack(cells):
+    """Smallest power-of-two atlas (square, then twice as wide) the cells fit in."""
+    size = GUTTER
+    while size <= MAX_SIZE:
+        for width, height in ((size, size), (size * 2, size)):
+            if width <= MAX_SIZE:
+                places = skyline_pack(cells, width, height)
+                if places is not None:
+                    return width, height, places
+        size *= 2
+    sys.exit("art does not fit a %dx%d atlas" % (MAX_SIZE, MAX_SIZE))
+
+
+def blit_extruded(atlas, atlas_width, image, x, y, cell):
+    """Copies the sprite to (x + GUTTER, y + GUTTER), repeating its edges to the cell's borders."""
+    width, height, rows = image
+    cell_width, cell_height = cell
+    right = cell_width - GUTTER - width
+    for cy in range(cell_height):
+        row = rows[min(max(cy - GUTTER, 0), height - 1)]
+        line = row[:4] * GUTTER + row + row[-4:] * right
+        at = ((y + cy) * atlas_width + x) * 4
+        atlas[at:at + cell_width * 4] = line
+
+
+# --- Output ---
+
+def header(width, height, rects):
+    lines = [
+        "// GENERATED by pack_atlas.py from art/ - do not edit by hand",
+        "#ifndef ATLAS_SPRITES_H",
+        "#define ATLAS_SPRITES_H",
+        "",
+        '#include "raylib.h"',
+        "",
+        "// atlas.png; 0x0 when there was no art to pack",
+        "const int ATLAS_WIDTH = %d;" % width,
+        "const int ATLAS_HEIGHT = %d;" % height,
+        "const int ATLAS_MIP_LEVELS = %d; // Levels that stay clean (trilinear filtering)" % MIP_LEVELS,
+        "",
+        "enum AtlasSprite {",
+    ]
+    for name, _ in SPRITES:
+        lines.append("    SPRITE_%s," % name)
+    lines += [
+        "    SPRITE_COUNT",
+        "};",
+        "",
+        "const int SPRITE_CARD_FACE_COUNT = %d; // SPRITE_CARD_FACE_00 onwards" % CARD_FACES,
+        "",
+        "// Pixel rects in atlas.png; zero-sized for missing art",
+        "const Rectangle ATLAS_RECTS[SPRITE_COUNT] = {",
+    ]
+    for (name, _), (x, y, w, h) in zip(SPRITES, rects):
+        lines.append("    { %d, %d, %d, %d }, // %s" % (x, y, w, h, name))
+    lines += ["};", "", "#endif", ""]
+    return "\n".join(lines)
+
+
+def main():
+    images = {}
+    for name, path in SPRITES:
+        full = os.path.join(ART, path)
+        if os.path.exists(full):
+            images[name] = read_png(full)
+
+    rects = [(0, 0, 0, 0)] * len(SPRITES)
+    width = height = 0
+    if images:
+        names = [name for name, _ in SPRITES if name in images]
+        cells = [cell_size(images[n][0], images[n][1]) for n in names]
+        width, height, places = pack(cells)
+        pixels = bytearray(width * height * 4)
+        for name, cell, (x, y) in zip(names, cells, places):
+            blit_extruded(pixels, width, images[name], x, y, cell)
+            index = [n for n, _ in SPRITES].index(name)
+            rects[index] = (x + GUTTER, y + GUTTER, images[name][0], images[name][1])
+        write_png(os.path.join(HERE, ATLAS), width, height, bytes(pixels))
+    elif os.path.exists(os.path.join(HERE, ATLAS)):
+        os.remove(os.path.join(HERE, ATLAS))  # A stale atlas would not match the header
+
+    with open(os.path.join(HERE, HEADER), "w") as f:
+        f.write(header(width, height, rects))
+    print("Packed %d of %d sprites into %s" % (len(images), len(SPRITES),
+                                               "a %dx%d atlas" % (width, height) if images else "no atlas"))
+
+
+if __name__ == "__main__":
+    main()
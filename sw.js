@@ -0,0 +1,41 @@
+// Offline cache, registered by minshell.html. Once installed the arcade boots without a
+// network, and a packed build (pack_assets.py) loads straight from the cache on repeat
+// visits. index.wasm is compiled from the cached response, which is what the browser keys
+// its compiled-code cache on, so repeat visits skip most of the compile as well.
+//
+// pack_assets.py rewrites the three lines below for dist/: its files have content-hashed
+// names, so they are served cache first, and a new build installs as a new cache that
+// takes over once no open page uses the old one. Unpacked (development) builds keep their
+// names from build to build, so they go to the network first and use the cache offline.
+const CACHE_NAME = 'arcade-dev';
+const PRECACHE = ['index.html', 'index.js', 'index.wasm'];
+const PACKED = false;
+
+self.addEventListener('install', event => {
+    event.waitUntil(caches.open(CACHE_NAME).then(cache => cache.addAll(PRECACHE)));
+});
+
+self.addEventListener('activate', event => {
+    event.waitUntil(caches.keys().then(names => Promise.all(
+        names.filter(name => name.startsWith('arcade-') && name !== CACHE_NAME).map(name => caches.delete(name)))));
+});
+
+// This origin's files only: the leaderboard is another origin and stays online-only.
+// Files not in PRECACHE (the side modules of the split build) are cached once fetched.
+self.addEventListener('fetch', event => {
+    const request = event.request;
+    if (request.method !== 'GET' || new URL(request.url).origin !== location.origin) return;
+    // Any navigation ("?p=<code>" share links too) is the one page
+    const navigation = request.mode === 'navigate';
+    const key = navigation ? 'index.html' : request;
+
+    event.respondWith(caches.open(CACHE_NAME).then(cache => {
+        const fromNetwork = () => fetch(request).then(response => {
+            if (response.ok) cache.put(key, response.clone());
+            return response;
+        });
+        const fromCache = () => cache.match(key, { ignoreSearch: navigation });
+        if (PACKED) return fromCache().then(cached => cached || fromNetwork());
+        return fromNetwork().catch(err => fromCache().then(cached => cached || Promise.reject(err)));
+    }));
+});
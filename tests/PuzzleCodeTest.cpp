@@ -0,0 +1,86 @@
+// Round-trip and uniqueness checks for the Killer share codes (PuzzleCode.h).
+// Build and run from the repository root (no raylib needed):
+//   g++ -std=c++17 -O2 -I. tests/PuzzleCodeTest.cpp PuzzleCode.cpp KillerSolver.cpp JobSystem.cpp -lpthread -o puzzle_code_test
+//   ./puzzle_code_test
+// Exits non-zero on the first failure.
+
+#include "PuzzleCode.h"
+#include "KillerSolver.h"
+#include "TestPuzzles.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+// Constants
+const int PUZZLES_PER_DIFFICULTY = 60;
+const long long UNIQUE_BUDGET = 5000000; // Nodes, as for a shared code in KillerSudoku.cpp
+const uint32_t TEST_SEED = 20261017;     // Fixed, so a failure reproduces
+
+static int failures = 0;
+
+static void Check(bool ok, const char* what, int puzzle) {
+    if (ok) return;
+    printf("FAIL puzzle %d: %s\n", puzzle, what);
+    failures++;
+}
+
+static bool SamePuzzle(const KillerPuzzle& a, const KillerPuzzle& b) {
+    return a.cageCount == b.cageCount && memcmp(a.cageOf, b.cageOf, 81) == 0
+        && memcmp(a.cageSum, b.cageSum, a.cageCount) == 0 && memcmp(a.given, b.given, 81) == 0;
+}
+
+int main() {
+    std::mt19937 rng(TEST_SEED);
+    std::set<std::string> codes;
+    int unique = 0;
+    int puzzles = 0;
+
+    for (int difficulty = 0; difficulty < 2; difficulty++) {
+        for (int n = 0; n < PUZZLES_PER_DIFFICULTY; n++, puzzles++) {
+            KillerPuzzle puzzle;
+            uint8_t solution[81];
+            Generate(difficulty, rng, puzzle, solution);
+
+            // Round trip: the decoded puzzle is the encoded one
+            std::string code = EncodeKillerCode(puzzle, difficulty);
+            Check(!code.empty() && code[0] == 'K', "encodes to a K code", puzzles);
+            KillerPuzzle decoded;
+            int decodedDifficulty = -1;
+            Check(DecodeKillerCode(code, decoded, decodedDifficulty), "decodes", puzzles);
+            Check(decodedDifficulty == difficulty, "keeps the difficulty", puzzles);
+            Check(SamePuzzle(puzzle, decoded), "decodes to the same puzzle", puzzles);
+            Check(codes.insert(code).second, "gets a code no other puzzle has", puzzles);
+            Check(ExtractPuzzleCode(("https://example.com/?p=" + code).c_str()) == code, "is found in a link", puzzles);
+
+            // Uniqueness survives the trip: a unique puzzle decodes to the same single solution
+            uint8_t solved[81];
+            int count = SolveKiller(puzzle, 2, solved, UNIQUE_BUDGET);
+            Check(count == 1 || count == 2, "is solved within the budget", puzzles);
+            if (count == 1) {
+                unique++;
+                Check(memcmp(solved, solution, 81) == 0, "unique solution is the generated grid", puzzles);
+                uint8_t fromCode[81];
+                Check(SolveKiller(decoded, 2, fromCode, UNIQUE_BUDGET) == 1, "decoded puzzle is unique too", puzzles);
+                Check(memcmp(fromCode, solution, 81) == 0, "decoded puzzle has the same solution", puzzles);
+            }
+
+            // Damage is rejected, never decoded into another puzzle: a flipped character
+            // fails the check byte (which lets about 1 in 256 through; none with TEST_SEED),
+            // a cut code reads too far past its end
+            std::string flipped = code;
+            size_t at = 1 + rng() % (code.size() - 1);
+            flipped[at] = flipped[at] == 'A' ? 'B' : 'A';
+            KillerPuzzle damaged;
+            int damagedDifficulty;
+            bool accepted = DecodeKillerCode(flipped, damaged, damagedDifficulty);
+            Check(!accepted || SamePuzzle(damaged, puzzle), "rejects a flipped character", puzzles);
+            Check(!DecodeKillerCode(code.substr(0, code.size() / 2), damaged, damagedDifficulty), "rejects a cut code", puzzles);
+        }
+    }
+
+    printf("%d puzzles, %d unique, %d failures\n", puzzles, unique, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// Symmetry checks for the Killer fingerprints (PuzzleFingerprint.h), and its line-order LIMIT.
+// Build and run from the repository root (no raylib needed):
+//   g++ -std=c++17 -O2 -I. tests/PuzzleFingerprintTest.cpp PuzzleFingerprint.cpp PuzzleTransform.cpp Snapshot.cpp RenderWorker.cpp -o puzzle_fingerprint_test
+//   ./puzzle_fingerprint_test
+// Exits non-zero if any check failed.
+
+#include "PuzzleFingerprint.h"
+#include "PuzzleTransform.h"
+#include "TestPuzzles.h"
+#include "js_interop.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+// Constants
+const int PUZZLES_PER_DIFFICULTY = 200;
+const int COPIES_PER_PUZZLE = 20;
+const uint32_t TEST_SEED = 20261017; // Fixed, so a failure reproduces
+
+static int failures = 0;
+
+// RecentPuzzleFilter saves through Snapshot.cpp, which flushes with this (js_interop.cpp, which
+// needs raylib); nothing is saved here
+void PersistSaveStorage() {}
+
+static void Check(bool ok, const char* what, int puzzle) {
+    if (ok) return;
+    printf("FAIL puzzle %d: %s\n", puzzle, what);
+    failures++;
+}
+
+int main() {
+    std::mt19937 rng(TEST_SEED);
+    int puzzles = 0;
+    int copies = 0;
+
+    // Generated puzzles stay inside the limit, so every symmetric copy shares the fingerprint,
+    // while the exact hash tells the copies apart
+    for (int difficulty = 0; difficulty < 2; difficulty++) {
+        for (int n = 0; n < PUZZLES_PER_DIFFICULTY; n++, puzzles++) {
+            SolvedPuzzle seed;
+            Generate(difficulty, rng, seed.puzzle, seed.solution);
+            bool complete = false;
+            CanonicalizeKiller(seed.puzzle, &complete);
+            Check(complete, "is canonicalized within the line-order limit", puzzles);
+
+            uint64_t fingerprint = FingerprintKiller(seed.puzzle);
+            uint64_t hash = HashKiller(seed.puzzle);
+            for (int k = 0; k < COPIES_PER_PUZZLE; k++, copies++) {
+                SolvedPuzzle copy = DeriveKiller(seed, rng);
+                Check(FingerprintKiller(copy.puzzle) == fingerprint, "copy has the same fingerprint", puzzles);
+                KillerPuzzle original = seed.puzzle;
+                NormalizeCageOrder(original);
+                bool sameBoard = memcmp(copy.puzzle.cageOf, original.cageOf, 81) == 0
+                    && memcmp(copy.puzzle.given, original.given, 81) == 0
+                    && memcmp(copy.puzzle.cageSum, original.cageSum, original.cageCount) == 0;
+                Check(sameBoard == (HashKiller(copy.puzzle) == hash), "copy has its own exact hash", puzzles);
+            }
+        }
+    }
+
+    // Past the limit: a board of one-cell cages gives every row and column the same signature.
+    // It is canonicalized from a subset of orderings, reported as incomplete, and still the
+    // same fingerprint every time for the same board.
+    SolvedPuzzle singles;
+    Generate(1, rng, singles.puzzle, singles.solution);
+    singles.puzzle.cageCount = 81;
+    for (int i = 0; i < 81; i++) {
+        singles.puzzle.cageOf[i] = (uint8_t)i;
+        singles.puzzle.cageSum[i] = singles.solution[i];
+        singles.puzzle.given[i] = 0;
+    }
+    bool complete = true;
+    CanonicalizeKiller(singles.puzzle, &complete);
+    Check(!complete, "one-cell cages go past the line-order limit", puzzles);
+    Check(FingerprintKiller(singles.puzzle) == FingerprintKiller(singles.puzzle), "fingerprint past the limit is repeatable", puzzles);
+
+    printf("%d puzzles, %d symmetric copies, %d failures\n", puzzles, copies, failures);
+    return failures == 0 ? 0 : 1;
+}
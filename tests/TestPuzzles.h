@@ -0,0 +1,82 @@
+// Test puzzles for the standalone tests in this directory: generated the way KillerSudokuGame
+// does it, without raylib.
+#ifndef TEST_PUZZLES_H
+#define TEST_PUZZLES_H
+
+#include "KillerPuzzle.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// --- A generator like KillerSudokuGame's: full grid, cages grown freely, givens for medium ---
+static bool Fill(uint8_t* grid, int index, std::mt19937& rng) {
+    if (index == 81) return true;
+    int digits[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::shuffle(digits, digits + 9, rng);
+    int row = index / 9, col = index % 9;
+    for (int d : digits) {
+        bool safe = true;
+        for (int k = 0; k < 9 && safe; k++) {
+            int boxCell = ((row / 3) * 3 + k / 3) * 9 + (col / 3) * 3 + k % 3;
+            safe = grid[row * 9 + k] != d && grid[k * 9 + col] != d && grid[boxCell] != d;
+        }
+        if (!safe) continue;
+        grid[index] = (uint8_t)d;
+        if (Fill(grid, index + 1, rng)) return true;
+        grid[index] = 0;
+    }
+    return false;
+}
+
+static void Generate(int difficulty, std::mt19937& rng, KillerPuzzle& puzzle, uint8_t* solution) {
+    memset(solution, 0, 81);
+    Fill(solution, 0, rng);
+
+    int maxCageSize = difficulty == 0 ? 3 : 5;
+    int cageOf[81];
+    for (int i = 0; i < 81; i++) cageOf[i] = -1;
+    std::vector<int> order(81);
+    for (int i = 0; i < 81; i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    int cages = 0;
+    for (int start : order) {
+        if (cageOf[start] != -1) continue;
+        std::vector<int> cells = { start };
+        cageOf[start] = cages;
+        int target = (int)(rng() % maxCageSize) + 1;
+        while ((int)cells.size() < target) {
+            std::vector<int> next;
+            for (int cell : cells) {
+                int r = cell / 9, c = cell % 9;
+                if (r > 0 && cageOf[cell - 9] == -1) next.push_back(cell - 9);
+                if (r < 8 && cageOf[cell + 9] == -1) next.push_back(cell + 9);
+                if (c > 0 && cageOf[cell - 1] == -1) next.push_back(cell - 1);
+                if (c < 8 && cageOf[cell + 1] == -1) next.push_back(cell + 1);
+            }
+            if (next.empty()) break;
+            int pick = next[rng() % next.size()];
+            cageOf[pick] = cages;
+            cells.push_back(pick);
+        }
+        int sum = 0;
+        for (int cell : cells) sum += solution[cell];
+        puzzle.cageSum[cages] = (uint8_t)sum;
+        cages++;
+    }
+    puzzle.cageCount = cages;
+    for (int i = 0; i < 81; i++) {
+        puzzle.cageOf[i] = (uint8_t)cageOf[i];
+        puzzle.given[i] = 0;
+    }
+    if (difficulty == 0) {
+        for (int k = 0; k < 10; k++) {
+            int cell = (int)(rng() % 81);
+            puzzle.given[cell] = solution[cell];
+        }
+    }
+    NormalizeCageOrder(puzzle);
+}
+
+#endif